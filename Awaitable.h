@@ -0,0 +1,606 @@
+/**
+ *  \file   Awaitable.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __AWAITABLE_H__
+#define __AWAITABLE_H__
+
+#if !defined(__cpp_impl_coroutine)
+#error "Awaitable.h requires C++20 coroutines"
+#endif
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Signal.h"
+
+namespace Signal
+{
+    /**
+     ******************************************************************
+     *
+     * @class async_handler
+     *
+     * The return type of a signal handler that is a coroutine. The
+     * coroutine starts running as soon as the handler is invoked, and
+     * whoever raised the signal carries on once it first suspends (e.g.
+     * at a co_await on an \ref Awaitable). Its frame is freed when it
+     * finishes, so there is nothing to hold on to:
+     *
+     * @code
+     * Signal::Awaitable<void,int> response;
+     *
+     * Signal::Signal<void,int> request([&](int id) -> Signal::async_handler
+     * {
+     *     send_request(id);
+     *     auto [status] = co_await response;
+     *     ...
+     * });
+     * @endcode
+     *
+     * @note An exception that escapes the coroutine calls
+     *       std::terminate()
+     *
+     ******************************************************************
+     */
+    class async_handler
+    {
+
+    public:
+
+#ifndef DOXYGEN_SKIP
+        struct promise_type
+        {
+            async_handler get_return_object() noexcept
+            {
+                return async_handler();
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return std::suspend_never();
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return std::suspend_never();
+            }
+
+            void return_void() noexcept
+            {
+            }
+
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+        };
+#endif
+    };
+
+    /**
+     ******************************************************************
+     *
+     * @class Awaitable
+     *
+     * A \ref Signal that coroutines can also wait on. A co_await on an
+     * Awaitable suspends until it is next raised, and then evaluates to
+     * a std::tuple of (copies of) the arguments it was raised with:
+     *
+     * @code
+     * Signal::Awaitable<void,int,std::string> on_message;
+     *
+     * Signal::async_handler session()
+     * {
+     *     for (;;)
+     *     {
+     *         auto [id, text] = co_await on_message;
+     *         ...
+     *     }
+     * }
+     * @endcode
+     *
+     * Each waiting coroutine is tracked by its awaiter, which lives in
+     * the coroutine's frame and is linked into a list kept by the
+     * Awaitable, so waiting never allocates memory. Raising the signal
+     * resumes the coroutines that were waiting when it was raised, in
+     * the order in which they began to wait, and then calls the handler
+     * (if one is attached). A coroutine that waits again once resumed
+     * waits for the next raise
+     *
+     * A coroutine destroyed while waiting drops out of the list. If the
+     * Awaitable is destroyed first, the coroutines still waiting on it
+     * are never resumed (but may still be destroyed). A resumed
+     * coroutine may destroy the Awaitable, e.g. once it has its last
+     * response; those resumed by the same raise are still resumed, but
+     * the handler is not called
+     *
+     * @note Arguments bound with bind() or forward() are kept by the
+     *       Awaitable rather than by its handler, so they are used when
+     *       it is raised through an Awaitable or a \ref generic, but not
+     *       through a reference to the Signal it derives from. Raising
+     *       it that way does not resume any coroutines either
+     *
+     * @note Copying or moving an Awaitable copies or moves its handler
+     *       and bound arguments, but not the coroutines waiting on it
+     *
+     * @tparam R  The signal handler's return type. If no handler is
+     *            attached, raise() returns a value-initialized R
+     * @tparam A  Specifies the type(s) of input arguments required by
+     *            the handler
+     *
+     ******************************************************************
+     */
+    template <class R, class... A>
+    class Awaitable : public Signal<R,A...>
+    {
+        using base_type = Signal<R,A...>;
+
+        struct waitlist;
+
+    public:
+
+        /**
+         * What a co_await on an Awaitable evaluates to
+         */
+        using value_type = std::tuple<typename std::decay<A>::type...>;
+
+        /**
+         ******************************************************************
+         *
+         * @class awaiter
+         *
+         * The state of one coroutine waiting on an \ref Awaitable. This is
+         * created by the co_await and lives in the coroutine's frame
+         *
+         ******************************************************************
+         */
+        class awaiter
+        {
+            friend class Awaitable<R,A...>;
+
+        public:
+
+            /**
+             * Constructor
+             *
+             * @param[in] sig The Awaitable to wait on
+             */
+            explicit awaiter(Awaitable<R,A...>& sig)
+                : _epoch(0), _handle(), _list(nullptr), _next(nullptr),
+                  _prev(nullptr), _sig(&sig), _value()
+            {
+            }
+
+            awaiter(const awaiter& other)            = delete;
+            awaiter& operator=(const awaiter& rhs)   = delete;
+
+            /**
+             * Destructor. Stops waiting if the coroutine is destroyed
+             * before the signal is raised
+             */
+            ~awaiter()
+            {
+                if (_list)
+                    Awaitable<R,A...>::unlink(*_list, this);
+            }
+
+            /**
+             * @return False, since we always wait for the next raise
+             */
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            /**
+             * @return The arguments the signal was raised with
+             */
+            value_type await_resume()
+            {
+                return std::move(*_value);
+            }
+
+            /**
+             * Start waiting for the signal to be raised
+             *
+             * @param[in] handle The coroutine to resume when it is
+             */
+            void await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                _handle = handle;
+                _sig->link(this);
+                _sig = nullptr;
+            }
+
+        private:
+
+            /*
+             * The number of times the signal had been raised when we
+             * started waiting
+             */
+            std::uint64_t _epoch;
+
+            std::coroutine_handle<> _handle;
+
+            /*
+             * The list we are waiting in, which is either the signal's
+             * or that of a raise about to resume us. Null once we are
+             * resumed, or the signal is destroyed
+             */
+            waitlist* _list;
+
+            awaiter* _next;
+            awaiter* _prev;
+
+            /*
+             * The signal to wait on, until we start waiting
+             */
+            Awaitable<R,A...>* _sig;
+
+            std::optional<value_type> _value;
+        };
+
+        using base_type::base_type;
+
+        /**
+         * Default constructor
+         */
+        Awaitable() : base_type()
+        {
+        }
+
+        /**
+         * Copy constructor. Copies the handler and bound arguments of \a
+         * other, but none of the coroutines waiting on it
+         *
+         * @param[in] other The Awaitable of which *this will be a copy
+         */
+        Awaitable(const Awaitable<R,A...>& other)
+            : base_type(other), _sargs(other._sargs)
+        {
+        }
+
+        /**
+         * Move constructor. Moves the handler and bound arguments of \a
+         * other, but none of the coroutines waiting on it, which go on
+         * waiting on \a other
+         *
+         * @param[in] other The Awaitable to move into *this
+         */
+        Awaitable(Awaitable<R,A...>&& other)
+            noexcept(std::is_nothrow_move_constructible<base_type>::value)
+            : base_type(std::move(other)), _sargs(std::move(other._sargs))
+        {
+        }
+
+        /**
+         * Destructor. Coroutines still waiting are never resumed
+         */
+        virtual ~Awaitable()
+        {
+            for (awaiter* node = _waiters.head; node; node = node->_next)
+                node->_list = nullptr;
+
+            if (_destroyed)
+                *_destroyed = true;
+        }
+
+        /**
+         * Copy assignment operator. This keeps the coroutines waiting on
+         * *this
+         *
+         * @param[in] rhs Another Awaitable to create a copy of
+         *
+         * @return *this
+         */
+        Awaitable<R,A...>& operator=(const Awaitable<R,A...>& rhs)
+        {
+            if (this != &rhs)
+            {
+                base_type::operator=(rhs);
+                _sargs = rhs._sargs;
+            }
+
+            return *this;
+        }
+
+        /**
+         * Move assignment operator. This keeps the coroutines waiting on
+         * *this, and leaves those waiting on \a rhs waiting on it
+         *
+         * @param[in] rhs Another Awaitable to move into *this
+         *
+         * @return *this
+         */
+        Awaitable<R,A...>& operator=(Awaitable<R,A...>&& rhs)
+            noexcept(std::is_nothrow_move_assignable<base_type>::value)
+        {
+            if (this != &rhs)
+            {
+                base_type::operator=(std::move(rhs));
+                _sargs = std::move(rhs._sargs);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Suspend the calling coroutine until the signal is next raised
+         *
+         * @return The awaiter, which yields the arguments it is raised
+         *         with
+         */
+        awaiter operator co_await() noexcept
+        {
+            return awaiter(*this);
+        }
+
+        /**
+         * Bind arguments to the signal handler and waiting coroutines.
+         * This avoids having to call raise() with explicit inputs
+         *
+         * @param[in] args Input arguments to implicitly forward
+         */
+        void bind(A... args)
+        {
+            _sargs.bind(std::forward<A>(args)...);
+        }
+
+        void bind_once(A... args) = delete;
+
+        /**
+         * A factory method that creates a copy of this object, without
+         * any of the coroutines waiting on it
+         *
+         * @return A \ref generic pointer to the newly created
+         *         object
+         */
+        generic* clone() const
+        {
+            return new Awaitable<R,A...>(*this);
+        }
+
+        /**
+         * A factory method that creates a copy of this object in memory
+         * drawn from \a mem, without any of the coroutines waiting on it
+         *
+         * @param[in] mem The arena from which to allocate the copy
+         *
+         * @return A \ref generic pointer to the newly created
+         *         object
+         */
+        generic* clone(arena& mem) const
+        {
+            return clone_in(mem, *this);
+        }
+
+        /**
+         * Forward arguments to the signal handler and waiting
+         * coroutines. Unlike \ref bind(), which forwards copies, this
+         * will forward \a args by reference
+         *
+         * @warning
+         * Forwarding references may lead to undefined behavior if you
+         * allow \a args to go out of scope
+         *
+         * @param[in] args Input arguments to implicitly forward
+         */
+        void forward(typename std::remove_reference<A>::type&... args)
+        {
+            _sargs.forward(args...);
+        }
+
+        /**
+         * Resume the coroutines waiting on the signal, giving each of
+         * them a copy of \a args, then invoke the handler
+         *
+         * @param[in] args The input arguments
+         *
+         * @return The return value of the handler, or a value-initialized
+         *         R if there is none or a resumed coroutine destroyed
+         *         the signal
+         */
+        R raise(A... args)
+        {
+            if (_waiters.head && !resume(static_cast<const A&>(args)...))
+                return R();
+
+            if (!this->is_connected())
+                return R();
+
+            return base_type::raise(std::forward<A>(args)...);
+        }
+
+        /**
+         * Forward bound arguments to the waiting coroutines and signal
+         * handler
+         *
+         * @return The return value of the handler
+         */
+        template <int N=0>
+        R raise()
+        {
+            return
+                run(typename gens<sizeof...(A)>::type());
+        }
+
+        /**
+         * Forward bound arguments to the waiting coroutines and signal
+         * handler
+         *
+         * This is equivalent to \ref raise() except that it can be
+         * invoked through a \ref generic
+         */
+        void v_raise()
+        {
+            raise();
+        }
+
+        /**
+         * @return The number of coroutines waiting on the signal
+         */
+        std::size_t waiting() const
+        {
+            return _waiters.size;
+        }
+
+    private:
+
+        /*
+         * A list of waiting coroutines, in the order they began to wait
+         */
+        struct waitlist
+        {
+            awaiter* head = nullptr;
+            awaiter* tail = nullptr;
+
+            std::size_t size = 0;
+        };
+
+        /*
+         * Append an awaiter to the waiting list
+         */
+        void link(awaiter* node) noexcept
+        {
+            node->_epoch = _emissions;
+            push(_waiters, node);
+        }
+
+        static void push(waitlist& list, awaiter* node) noexcept
+        {
+            node->_list = &list;
+            node->_prev = list.tail;
+            node->_next = nullptr;
+
+            if (list.tail)
+                list.tail->_next = node;
+            else
+                list.head = node;
+
+            list.tail = node;
+            list.size++;
+        }
+
+        /*
+         * Resume every coroutine that was waiting when we were raised.
+         * Those that start waiting again as a result have a later epoch,
+         * and so are left for the next raise
+         *
+         * They are first moved to a list of our own, with their values,
+         * so that nothing of *this is used once any of them has run. Any
+         * of them destroyed before its turn drops out of that list
+         *
+         * Returns false if a resumed coroutine destroyed *this
+         */
+        template <class... T>
+        bool resume(const T&... args)
+        {
+            const std::uint64_t epoch = _emissions++;
+
+            waitlist due;
+            while (_waiters.head && _waiters.head->_epoch <= epoch)
+            {
+                awaiter* node = _waiters.head;
+                unlink(_waiters, node);
+
+                node->_value.emplace(args...);
+                push(due, node);
+            }
+
+            resume_scope scope(*this);
+
+            while (due.head)
+            {
+                awaiter* node = due.head;
+                unlink(due, node);
+
+                node->_handle.resume();
+            }
+
+            return !scope.destroyed;
+        }
+
+        /*
+         * Lets the destructor tell a raise that is resuming coroutines
+         * (and any raise it is nested in) that *this is gone
+         */
+        struct resume_scope
+        {
+            explicit resume_scope(Awaitable<R,A...>& sig)
+                : destroyed(false), outer(sig._destroyed), self(&sig)
+            {
+                sig._destroyed = &destroyed;
+            }
+
+            ~resume_scope()
+            {
+                if (!destroyed)
+                    self->_destroyed = outer;
+                else if (outer)
+                    *outer = true;
+            }
+
+            bool destroyed;
+            bool* outer;
+
+            Awaitable<R,A...>* self;
+        };
+
+        template<int... S>
+        R run(seq<S...>)
+        {
+            if (_sargs.has_refs())
+                return raise(*std::get<S>(_sargs.ptrs())... );
+            else
+                return raise( std::get<S>(_sargs.args())... );
+        }
+
+        /*
+         * Remove an awaiter from the list it is waiting in
+         */
+        static void unlink(waitlist& list, awaiter* node) noexcept
+        {
+            if (node->_prev)
+                node->_prev->_next = node->_next;
+            else
+                list.head = node->_next;
+
+            if (node->_next)
+                node->_next->_prev = node->_prev;
+            else
+                list.tail = node->_prev;
+
+            node->_list = nullptr;
+            list.size--;
+        }
+
+        /*
+         * While coroutines are being resumed, where to record that one
+         * of them destroyed us. These have initializers so that the
+         * inherited constructors set them
+         */
+        bool* _destroyed = nullptr;
+
+        /*
+         * The number of times we have resumed waiting coroutines
+         */
+        std::uint64_t _emissions = 0;
+
+        SignalArgs< A... >
+            _sargs;
+
+        waitlist _waiters;
+    };
+}
+
+#endif // __AWAITABLE_H__
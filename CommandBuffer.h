@@ -0,0 +1,454 @@
+/**
+ *  \file   CommandBuffer.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __COMMAND_BUFFER_H__
+#define __COMMAND_BUFFER_H__
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Signal.h"
+
+namespace Signal
+{
+    /**
+     ******************************************************************
+     *
+     * @class CommandBuffer
+     *
+     * Records calls to signal handlers, together with the arguments to
+     * call them with, for replaying later. This is similar to binding
+     * arguments to a signal and calling v_raise() at some later time,
+     * except that every recorded call is laid out one after another
+     * in a single growable block of memory rather than being a signal
+     * of its own
+     *
+     * replay() makes the recorded calls in order. clear() discards
+     * them but keeps the memory, so a buffer that is filled and
+     * cleared repeatedly stops allocating once it has grown to fit
+     *
+     * @note Handlers must not record into the CommandBuffer that is
+     *       replaying them
+     *
+     ******************************************************************
+     */
+    class CommandBuffer
+    {
+        struct ops
+        {
+            void (*invoke)(void*);
+            void (*move)(void* dst, void* src);
+            void (*copy)(void* dst, void* src);
+            void (*destroy)(void*);
+        };
+
+        template <class P>
+        struct command_ops
+        {
+            static void invoke(void* p)
+            {
+                (*static_cast<P*>(p))();
+            }
+
+            static void move(void* dst, void* src)
+            {
+                ::new (dst) P(std::move(*static_cast<P*>(src)));
+                static_cast<P*>(src)->~P();
+            }
+
+            /*
+             * Used instead of move() when moving might throw, so that
+             * a failed relocation leaves the source intact. Only ever
+             * called for a P that can be copied (see emplace())
+             */
+            static void copy(void* dst, void* src)
+            {
+                ::new (dst) P(std::move_if_noexcept(*static_cast<P*>(src)));
+            }
+
+            static void destroy(void* p)
+            {
+                static_cast<P*>(p)->~P();
+            }
+
+            /*
+             * Trivial commands are relocated with memcpy and need no
+             * destroying, so their table leaves those entries null.
+             * Commands have either move() or copy(), depending on
+             * whether moving them might throw
+             */
+            static const ops table;
+        };
+
+        /*
+         * Precedes each command in the buffer
+         */
+        struct header
+        {
+            const ops*  table;
+            std::size_t size;
+        };
+
+        static const std::size_t align = alignof(std::max_align_t);
+
+        static const std::size_t payload_offset =
+            (sizeof(header) + align - 1) / align * align;
+
+        /*
+         * A recorded call: a handler and the arguments to pass to it
+         */
+        template <class F, class... A>
+        struct command
+        {
+            template <class... T>
+            command(const F& f, T&&... args)
+                : func(f), args(std::forward<T>(args)...)
+            {
+            }
+
+            void operator()()
+            {
+                run(typename gens<sizeof...(A)>::type());
+            }
+
+            template <int... S>
+            void run(seq<S...>)
+            {
+                func(std::get<S>(args)...);
+            }
+
+            F func;
+
+            std::tuple<typename std::remove_const<
+                       typename std::remove_reference<A>::type>::type...>
+                args;
+        };
+
+        template <class C, class M>
+        struct mem_call
+        {
+            template <class... T>
+            void operator()(T&&... args) const
+            {
+                (obj->*method)(std::forward<T>(args)...);
+            }
+
+            C* obj;
+            M  method;
+        };
+
+        template <class S>
+        struct signal_call
+        {
+            template <class... T>
+            void operator()(T&&... args) const
+            {
+                sig->raise(std::forward<T>(args)...);
+            }
+
+            S* sig;
+        };
+
+    public:
+
+        /**
+         * Constructor
+         *
+         * @param[in] capacity The number of bytes to reserve up front
+         */
+        explicit CommandBuffer(std::size_t capacity = 1024)
+            : _buf(nullptr), _capacity(0), _count(0), _used(0)
+        {
+            reserve(capacity);
+        }
+
+        CommandBuffer(const CommandBuffer& other)          = delete;
+        CommandBuffer& operator=(const CommandBuffer& rhs) = delete;
+
+        /**
+         * Destructor
+         */
+        ~CommandBuffer()
+        {
+            clear();
+            ::operator delete(_buf);
+        }
+
+        /**
+         * @return The number of bytes the buffer can hold before it
+         *         must grow
+         */
+        std::size_t capacity() const
+        {
+            return _capacity;
+        }
+
+        /**
+         * Discard every recorded call. The memory is kept for reuse
+         */
+        void clear()
+        {
+            for (std::size_t offset = 0; offset < _used; )
+            {
+                header* h = reinterpret_cast<header*>(_buf + offset);
+
+                if (h->table->destroy)
+                    h->table->destroy(_buf + offset + payload_offset);
+
+                offset += h->size;
+            }
+
+            _count = 0; _used = 0;
+        }
+
+        /**
+         * @return True if no calls are recorded
+         */
+        bool empty() const
+        {
+            return _count == 0;
+        }
+
+        /**
+         * Record a call to a handler which is a C-style function
+         * pointer
+         *
+         * @param[in] func The handler
+         * @param[in] args The arguments to call it with, which are
+         *                 copied (or moved) into the buffer
+         */
+        template <class R, class... A, class... T>
+        void record(R(*func)(A...), T&&... args)
+        {
+            emplace<command<R(*)(A...),A...>>(func,
+                std::forward<T>(args)...);
+        }
+
+        /**
+         * Record a call to a handler which is a member of class C
+         *
+         * @param[in] obj  Object (of class C) through which to invoke
+         *                 the handler
+         * @param[in] func A pointer to the handler
+         * @param[in] args The arguments to call it with
+         */
+        template <class C, class R, class... A, class... T>
+        void record(C& obj, R(C::*func)(A...), T&&... args)
+        {
+            typedef mem_call<C, R(C::*)(A...)> call;
+
+            const call f = { &obj, func };
+            emplace<command<call,A...>>(f, std::forward<T>(args)...);
+        }
+
+        /**
+         * Record a call to a handler which is a *const* member of
+         * class C
+         *
+         * @param[in] obj  Object (of class C) through which to invoke
+         *                 the handler
+         * @param[in] func A pointer to the *const* handler
+         * @param[in] args The arguments to call it with
+         */
+        template <class C, class R, class... A, class... T>
+        void record(const C& obj, R(C::*func)(A...) const, T&&... args)
+        {
+            typedef mem_call<const C, R(C::*)(A...) const> call;
+
+            const call f = { &obj, func };
+            emplace<command<call,A...>>(f, std::forward<T>(args)...);
+        }
+
+        /**
+         * Record a call to raise() on a Signal. The Signal is raised
+         * with whichever handler it has at the time of replay()
+         *
+         * @param[in] sig  The Signal to raise
+         * @param[in] args The arguments to raise it with
+         */
+        template <class R, class... A, class... T>
+        void record(Signal<R,A...>& sig, T&&... args)
+        {
+            typedef signal_call<Signal<R,A...>> call;
+
+            const call f = { &sig };
+            emplace<command<call,A...>>(f, std::forward<T>(args)...);
+        }
+
+        /**
+         * Make every recorded call, in the order in which they were
+         * recorded. The calls remain recorded, so replay() may be
+         * called again
+         */
+        void replay()
+        {
+            for (std::size_t offset = 0; offset < _used; )
+            {
+                header* h = reinterpret_cast<header*>(_buf + offset);
+
+                h->table->invoke(_buf + offset + payload_offset);
+                offset += h->size;
+            }
+        }
+
+        /**
+         * Make sure the buffer can hold at least \a bytes bytes. If
+         * copying a recorded call throws, the buffer is left as it was
+         * and the exception is passed on
+         *
+         * @param[in] bytes The number of bytes to make room for
+         */
+        void reserve(std::size_t bytes)
+        {
+            if (bytes <= _capacity)
+                return;
+
+            unsigned char* buf =
+                static_cast<unsigned char*>(::operator new(bytes));
+
+            std::size_t offset = 0;
+
+            try
+            {
+                while (offset < _used)
+                {
+                    header* h = reinterpret_cast<header*>(_buf + offset);
+
+                    unsigned char* dst = buf  + offset + payload_offset;
+                    unsigned char* src = _buf + offset + payload_offset;
+
+                    if (h->table->move)
+                        h->table->move(dst, src);
+                    else if (h->table->copy)
+                        h->table->copy(dst, src);
+                    else
+                        std::memcpy(dst, src, h->size - payload_offset);
+
+                    std::memcpy(buf + offset, h, sizeof(header));
+                    offset += h->size;
+                }
+            }
+            catch (...)
+            {
+                /*
+                 * Move the calls already moved back, and destroy the
+                 * copies. Neither throws
+                 */
+                for (std::size_t i = 0; i < offset; )
+                {
+                    header* h = reinterpret_cast<header*>(buf + i);
+
+                    if (h->table->move)
+                    {
+                        h->table->move(_buf + i + payload_offset,
+                                       buf  + i + payload_offset);
+                    }
+                    else if (h->table->destroy)
+                        h->table->destroy(buf + i + payload_offset);
+
+                    i += h->size;
+                }
+
+                ::operator delete(buf);
+                throw;
+            }
+
+            /*
+             * The calls that were copied rather than moved still need
+             * destroying
+             */
+            for (std::size_t i = 0; i < _used; )
+            {
+                header* h = reinterpret_cast<header*>(_buf + i);
+
+                if (h->table->copy && h->table->destroy)
+                    h->table->destroy(_buf + i + payload_offset);
+
+                i += h->size;
+            }
+
+            ::operator delete(_buf);
+            _buf = buf; _capacity = bytes;
+        }
+
+        /**
+         * @return The number of recorded calls
+         */
+        std::size_t size() const
+        {
+            return _count;
+        }
+
+        /**
+         * @return The number of bytes taken up by recorded calls
+         */
+        std::size_t used() const
+        {
+            return _used;
+        }
+
+    private:
+
+        template <class P, class... T>
+        void emplace(T&&... args)
+        {
+            static_assert(alignof(P) <= align,
+                          "Command is over-aligned");
+
+            static_assert(std::is_nothrow_move_constructible<P>::value ||
+                          std::is_copy_constructible<P>::value,
+                          "Arguments must be copyable or nothrow movable");
+
+            const std::size_t size =
+                (payload_offset + sizeof(P) + align - 1) / align * align;
+
+            if (_used + size > _capacity)
+            {
+                reserve(_used + size > 2 * _capacity ?
+                        _used + size : 2 * _capacity);
+            }
+
+            unsigned char* at = _buf + _used;
+
+            ::new (static_cast<void*>(at + payload_offset))
+                P(std::forward<T>(args)...);
+
+            header h = { &command_ops<P>::table, size };
+            ::new (static_cast<void*>(at)) header(h);
+
+            _count++; _used += size;
+        }
+
+        unsigned char* _buf;
+
+        std::size_t _capacity;
+
+        std::size_t _count;
+
+        std::size_t _used;
+    };
+
+#ifndef DOXYGEN_SKIP
+    template <class P>
+    const CommandBuffer::ops CommandBuffer::command_ops<P>::table = {
+        &CommandBuffer::command_ops<P>::invoke,
+        std::is_trivially_copyable<P>::value ||
+        !std::is_nothrow_move_constructible<P>::value ?
+            nullptr : &CommandBuffer::command_ops<P>::move,
+        std::is_nothrow_move_constructible<P>::value ?
+            nullptr : &CommandBuffer::command_ops<P>::copy,
+        std::is_trivially_destructible<P>::value ?
+            nullptr : &CommandBuffer::command_ops<P>::destroy
+    };
+#endif
+}
+
+#endif // __COMMAND_BUFFER_H__
@@ -0,0 +1,456 @@
+/**
+ *  \file   ConcurrentMulticast.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __CONCURRENT_MULTICAST_H__
+#define __CONCURRENT_MULTICAST_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Multicast.h"
+
+namespace Signal
+{
+    /**
+     ******************************************************************
+     *
+     * @class ConcurrentMulticast
+     *
+     * A \ref Multicast that may be raised from any number of threads
+     * while handlers are being connected and disconnected from others
+     *
+     * The handlers are kept in an immutable snapshot. raise() simply
+     * registers itself as a reader, loads the current snapshot and
+     * invokes each handler in it, so it never waits on anything.
+     * connect() and disconnect() copy the snapshot, modify the copy
+     * and publish it; they serialize with one another but never wait
+     * for raise(). Replaced snapshots are freed once every raise()
+     * that could still be reading them has returned
+     *
+     * @note A raise() already underway when disconnect() returns may
+     *       still invoke the disconnected handler. Call synchronize()
+     *       before destroying the object a handler is invoked on
+     *
+     * @tparam R  The handlers' return type. Return values are ignored
+     * @tparam A  Specifies the type(s) of input arguments required by
+     *            the handlers
+     *
+     ******************************************************************
+     */
+    template <class R, class... A>
+    class ConcurrentMulticast
+    {
+        using slot_type = slot<R,A...>;
+
+        /*
+         * A published list of handlers. Once published, a snapshot is
+         * never modified
+         */
+        struct snapshot
+        {
+            std::vector<std::uint64_t> ids;
+            std::vector<slot_type>     slots;
+
+            std::uint64_t retired_epoch;
+            snapshot*     next_retired;
+        };
+
+        /*
+         * Readers are counted per epoch parity, spread across several
+         * cache lines to keep raising threads from contending on one
+         */
+        struct alignas(64) reader_shard
+        {
+            std::atomic<std::size_t> count[2];
+        };
+
+        static const std::size_t num_shards = 8;
+
+        /*
+         * Registers a raise() with the reader count for the current
+         * epoch for as long as it is in scope
+         */
+        class read_guard
+        {
+
+        public:
+
+            read_guard(const ConcurrentMulticast<R,A...>& sig)
+                : _count(sig._readers[shard_index()].count[
+                      sig._epoch.load() & 1])
+            {
+                _count.fetch_add(1);
+            }
+
+            ~read_guard()
+            {
+                _count.fetch_sub(1);
+            }
+
+        private:
+
+            std::atomic<std::size_t>& _count;
+        };
+
+    public:
+
+        /**
+         * Default constructor
+         */
+        ConcurrentMulticast()
+            : _epoch(0), _head(new snapshot()), _next_id(1),
+              _owner(connection::new_owner()),
+              _retired(nullptr), _write_lock()
+        {
+            for (std::size_t i = 0; i < num_shards; i++)
+            {
+                _readers[i].count[0].store(0);
+                _readers[i].count[1].store(0);
+            }
+        }
+
+        ConcurrentMulticast(const ConcurrentMulticast<R,A...>& other)
+            = delete;
+        ConcurrentMulticast<R,A...>&
+            operator=(const ConcurrentMulticast<R,A...>& rhs) = delete;
+
+        /**
+         * Destructor. No thread may be raising this signal
+         */
+        ~ConcurrentMulticast()
+        {
+            delete _head.load();
+
+            while (_retired)
+            {
+                snapshot* next = _retired->next_retired;
+                delete _retired; _retired = next;
+            }
+        }
+
+        /**
+         * Connect a handler which is a C-style function pointer
+         *
+         * @param[in] func The handler
+         *
+         * @return The new connection, which is invalid if \a func is
+         *         null
+         */
+        connection connect(R(*func)(A...))
+        {
+            if (func == nullptr)
+                return connection();
+
+            slot_type s;
+            s.set(nullptr, func, &slot_type::call);
+
+            return add(s);
+        }
+
+        /**
+         * Connect a handler which is a member of class C
+         *
+         * @tparam C Class that implements the handler
+         *
+         * @param[in] obj  Object (of class C) through which to invoke
+         *                 the handler
+         * @param[in] func A pointer to the handler
+         *
+         * @return The new connection, which is invalid if \a func is
+         *         null
+         */
+        template <typename C>
+        connection connect(C& obj, R(C::*func)(A...))
+        {
+            using F = R(C::*)(A...);
+
+            if (func == nullptr)
+                return connection();
+
+            slot_type s;
+            s.set(&obj, func,
+                  &slot_type::template call_mem<C,F>);
+
+            return add(s);
+        }
+
+        /**
+         * Connect a handler which is a *const* member of class C
+         *
+         * @tparam C Class that implements the handler
+         *
+         * @param[in] obj  Object (of class C) through which to invoke
+         *                 the handler
+         * @param[in] func A pointer to the *const* handler
+         *
+         * @return The new connection, which is invalid if \a func is
+         *         null
+         */
+        template <typename C>
+        connection connect(const C& obj, R(C::*func)(A...) const)
+        {
+            using F = R(C::*)(A...) const;
+
+            if (func == nullptr)
+                return connection();
+
+            slot_type s;
+            s.set(const_cast<C*>(&obj), func,
+                  &slot_type::template call_mem<const C,F>);
+
+            return add(s);
+        }
+
+        /**
+         * Disconnect a handler
+         *
+         * @param[in] conn The connection returned when the handler was
+         *                 connected
+         *
+         * @return True on success, or false if \a conn does not refer
+         *         to a handler of this signal
+         */
+        bool disconnect(const connection& conn)
+        {
+            if (conn.owner() != _owner)
+                return false;
+
+            std::lock_guard<std::mutex> lock(_write_lock);
+
+            const snapshot* current = _head.load();
+
+            for (std::size_t i = 0; i < current->ids.size(); i++)
+            {
+                if (current->ids[i] == conn.id())
+                {
+                    snapshot* next = new snapshot(*current);
+
+                    next->ids.erase(next->ids.begin() + i);
+                    next->slots.erase(next->slots.begin() + i);
+
+                    publish(next);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /**
+         * Disconnect all handlers
+         */
+        void disconnect_all()
+        {
+            std::lock_guard<std::mutex> lock(_write_lock);
+            publish(new snapshot());
+        }
+
+        /**
+         * Check whether any handlers are connected to this signal
+         *
+         * @return True if at least one handler is connected
+         */
+        bool is_connected() const
+        {
+            read_guard guard(*this);
+            return !_head.load()->slots.empty();
+        }
+
+        /**
+         * Check whether a particular handler is connected
+         *
+         * @param[in] conn The connection returned when the handler was
+         *                 connected
+         *
+         * @return True if the handler is still connected
+         */
+        bool is_connected(const connection& conn) const
+        {
+            if (conn.owner() != _owner)
+                return false;
+
+            read_guard guard(*this);
+
+            const snapshot* current = _head.load();
+
+            for (std::size_t i = 0; i < current->ids.size(); i++)
+            {
+                if (current->ids[i] == conn.id())
+                    return true;
+            }
+
+            return false;
+        }
+
+        /**
+         * Invoke each of the signal handlers connected at the time of
+         * the call, in the order in which they were connected. This
+         * is safe to call from any number of threads concurrently
+         *
+         * @param[in] args The input arguments to provide the handlers
+         *                 with
+         */
+        void raise(typename slot_arg<A>::type... args) const
+        {
+            read_guard guard(*this);
+
+            const snapshot* current = _head.load();
+
+            const slot_type* s   = current->slots.data();
+            const slot_type* end = s + current->slots.size();
+
+            for (; s != end; ++s)
+                s->thunk(*s, args...);
+        }
+
+        /**
+         * @return The number of connected handlers
+         */
+        std::size_t size() const
+        {
+            read_guard guard(*this);
+            return _head.load()->slots.size();
+        }
+
+        /**
+         * Wait for every raise() that began before this call to return.
+         * After disconnecting a handler, this guarantees it is no longer
+         * being invoked
+         *
+         * @warning Calling this from a handler of this signal will
+         *          deadlock
+         */
+        void synchronize()
+        {
+            std::lock_guard<std::mutex> lock(_write_lock);
+
+            const std::uint64_t target = _epoch.load() + 2;
+
+            while (_epoch.load() < target)
+            {
+                if (!try_advance())
+                    std::this_thread::yield();
+            }
+
+            reclaim();
+        }
+
+    private:
+
+        connection add(const slot_type& s)
+        {
+            std::lock_guard<std::mutex> lock(_write_lock);
+
+            snapshot* next = new snapshot(*_head.load());
+
+            next->ids.push_back(_next_id);
+            next->slots.push_back(s);
+
+            publish(next);
+
+            return connection(_owner, _next_id++);
+        }
+
+        /*
+         * Replace the current snapshot with \a next and retire the old
+         * one. Must be called with the write lock held
+         */
+        void publish(snapshot* next)
+        {
+            snapshot* old = _head.exchange(next);
+
+            old->retired_epoch = _epoch.load();
+            old->next_retired  = _retired;
+            _retired = old;
+
+            if (try_advance())
+                try_advance();
+
+            reclaim();
+        }
+
+        /*
+         * Free every retired snapshot that no reader can still hold. A
+         * snapshot retired during epoch e is unreachable once the epoch
+         * has advanced twice, since each advance waits for the readers
+         * of one parity to drain
+         */
+        void reclaim()
+        {
+            const std::uint64_t epoch = _epoch.load();
+
+            snapshot** link = &_retired;
+            while (*link)
+            {
+                snapshot* s = *link;
+
+                if (s->retired_epoch + 2 <= epoch)
+                {
+                    *link = s->next_retired;
+                    delete s;
+                }
+                else
+                    link = &s->next_retired;
+            }
+        }
+
+        /*
+         * Advance the epoch if no readers that entered during the
+         * previous epoch remain. New readers count themselves against
+         * the current epoch, so this never waits on them
+         */
+        bool try_advance()
+        {
+            const std::uint64_t epoch = _epoch.load();
+            const std::size_t   prev  = (epoch - 1) & 1;
+
+            for (std::size_t i = 0; i < num_shards; i++)
+            {
+                if (_readers[i].count[prev].load() != 0)
+                    return false;
+            }
+
+            _epoch.store(epoch + 1);
+            return true;
+        }
+
+        static std::size_t shard_index()
+        {
+            static std::atomic<std::size_t> next(0);
+            static thread_local std::size_t index =
+                next.fetch_add(1) % num_shards;
+
+            return index;
+        }
+
+        std::atomic<std::uint64_t>
+            _epoch;
+
+        std::atomic<snapshot*>
+            _head;
+
+        std::uint64_t _next_id;
+
+        /*
+         * The token carried by every connection this signal makes
+         */
+        const std::uint64_t _owner;
+
+        mutable reader_shard
+            _readers[num_shards];
+
+        snapshot* _retired;
+
+        std::mutex _write_lock;
+    };
+}
+
+#endif // __CONCURRENT_MULTICAST_H__
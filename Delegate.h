@@ -0,0 +1,218 @@
+/**
+ *  \file   Delegate.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __DELEGATE_H__
+#define __DELEGATE_H__
+
+#include <type_traits>
+#include <utility>
+
+#include "Signal.h"
+
+namespace Signal
+{
+    /**
+     ******************************************************************
+     *
+     * @class Delegate
+     *
+     * A signal that is just two pointers: the target (an object or a
+     * function pointer) and a thunk that invokes the handler on it.
+     * A Delegate is trivially copyable, so arrays of them may be
+     * copied or relocated with memcpy, and it has no virtual methods
+     *
+     * Handlers that are member functions are given as template
+     * arguments, like \ref static_mem, so that only the object needs
+     * storing. For example:
+     *
+     * @code
+     * using delegate = Signal::Delegate<void,int>;
+     *
+     * delegate d1(&handler);
+     * delegate d2 = delegate::from<MyClass, &MyClass::handler>(obj);
+     *
+     * d1.raise(1); d2.raise(2);
+     * @endcode
+     *
+     * @note A Delegate holds raw addresses, so it does not keep its
+     *       object alive, and a table of them is only valid within
+     *       the process that built it
+     *
+     * @tparam R  The signal handler return type
+     * @tparam A  Specifies the type(s) of input arguments required by
+     *            the handler
+     *
+     ******************************************************************
+     */
+    template <class R, class... A>
+    class Delegate
+    {
+        using Handler = R(*)(A...);
+
+        union target
+        {
+            void*   obj;
+            Handler func;
+        };
+
+        using thunk_type = R(*)(target, A&&...);
+
+    public:
+
+        /**
+         * Default constructor. Creates a Delegate with no handler
+         */
+        Delegate() : _target(), _thunk(nullptr)
+        {
+            _target.obj = nullptr;
+        }
+
+        /**
+         * Create a Delegate whose handler is a C-style function pointer
+         *
+         * @param[in] func The handler
+         */
+        Delegate(Handler func) : _target(), _thunk(nullptr)
+        {
+            _target.func = func;
+
+            if (func != nullptr)
+                _thunk = &call;
+        }
+
+        /**
+         * Create a Delegate whose handler is a C-style function known
+         * at compile time
+         *
+         * @tparam func The handler
+         *
+         * @return The new Delegate
+         */
+        template <Handler func>
+        static Delegate<R,A...> from()
+        {
+            return Delegate<R,A...>(nullptr, &call_static<func>);
+        }
+
+        /**
+         * Create a Delegate whose handler is a member of class C
+         *
+         * @tparam C      Class that implements the handler
+         * @tparam method The handler
+         *
+         * @param[in] obj Object (of class C) through which to invoke
+         *                the handler
+         *
+         * @return The new Delegate
+         */
+        template <class C, R(C::*method)(A...)>
+        static Delegate<R,A...> from(C& obj)
+        {
+            return Delegate<R,A...>(&obj, &call_mem<C,method>);
+        }
+
+        /**
+         * Create a Delegate whose handler is a *const* member of class C
+         *
+         * @tparam C      Class that implements the handler
+         * @tparam method The *const* handler
+         *
+         * @param[in] obj Object (of class C) through which to invoke
+         *                the handler
+         *
+         * @return The new Delegate
+         */
+        template <class C, R(C::*method)(A...) const>
+        static Delegate<R,A...> from(const C& obj)
+        {
+            return Delegate<R,A...>(const_cast<C*>(&obj),
+                                    &call_const<C,method>);
+        }
+
+        /**
+         * Determine if a handler is attached
+         *
+         * @return True if attached
+         */
+        bool is_connected() const
+        {
+            return _thunk != nullptr;
+        }
+
+        /**
+         * Invoke the signal handler. This will fail if no handler is
+         * attached, which can be verified with is_connected()
+         *
+         * @param[in] args The input arguments to provide the handler
+         *                 with
+         *
+         * @return The return value of the handler
+         */
+        R raise(A... args) const
+        {
+            return _thunk(_target, std::forward<A>(args)...);
+        }
+
+        /**
+         * Check whether two Delegates invoke the same handler on the
+         * same target
+         */
+        bool operator==(const Delegate<R,A...>& rhs) const
+        {
+            if (_thunk != rhs._thunk)
+                return false;
+            else if (_thunk == &call)
+                return _target.func == rhs._target.func;
+            else
+                return _target.obj  == rhs._target.obj;
+        }
+
+        bool operator!=(const Delegate<R,A...>& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+
+        Delegate(void* obj, thunk_type thunk)
+            : _target(), _thunk(thunk)
+        {
+            _target.obj = obj;
+        }
+
+        static R call(target t, A&&... args)
+        {
+            return t.func(std::forward<A>(args)...);
+        }
+
+        template <Handler func>
+        static R call_static(target, A&&... args)
+        {
+            return func(std::forward<A>(args)...);
+        }
+
+        template <class C, R(C::*method)(A...)>
+        static R call_mem(target t, A&&... args)
+        {
+            return (static_cast<C*>(t.obj)->*method)(
+                std::forward<A>(args)...);
+        }
+
+        template <class C, R(C::*method)(A...) const>
+        static R call_const(target t, A&&... args)
+        {
+            return (static_cast<const C*>(t.obj)->*method)(
+                std::forward<A>(args)...);
+        }
+
+        target _target;
+
+        thunk_type _thunk;
+    };
+}
+
+#endif // __DELEGATE_H__
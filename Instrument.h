@@ -0,0 +1,449 @@
+/**
+ *  \file   Instrument.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __INSTRUMENT_H__
+#define __INSTRUMENT_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <ostream>
+
+namespace Signal
+{
+    /**
+     ******************************************************************
+     *
+     * @class stats
+     *
+     * Counts calls and keeps a histogram of their latencies. Buckets
+     * are laid out as in an HDR histogram: each power of two is split
+     * into 8 equal sub-buckets, so a recorded latency is off by at
+     * most 1/8th of its value. Latencies of 2^36 ns (about a minute)
+     * or more share the last bucket
+     *
+     * Each thread records into one of several shards, and only with
+     * relaxed atomic adds, so recording takes no locks. snapshot()
+     * sums the shards into a \ref stats::summary
+     *
+     * Every stats object registers itself on construction, so that
+     * the stats for all signals can be printed with dump_all() or
+     * combined with aggregate()
+     *
+     * When Signal.h is compiled with SIGNAL_INSTRUMENT defined, a
+     * Signal may be given a stats object with set_stats(), and will
+     * then time each of its raises. Without SIGNAL_INSTRUMENT, Signal
+     * has no instrumentation code at all
+     *
+     ******************************************************************
+     */
+    class stats
+    {
+
+    public:
+
+        /**
+         * The number of histogram buckets
+         */
+        static const std::size_t buckets = 272;
+
+        /**
+         * The number of shards that threads record into
+         */
+        static const std::size_t shards = 8;
+
+        /**
+         * A point-in-time copy of a \ref stats, or the sum of several
+         */
+        struct summary
+        {
+            summary() : count(0), max(0), min(0), total(0), counts()
+            {
+            }
+
+            /**
+             * Add another summary into this one
+             *
+             * @param[in] rhs The summary to add
+             *
+             * @return *this
+             */
+            summary& operator+=(const summary& rhs)
+            {
+                if (rhs.count == 0)
+                    return *this;
+
+                if (count == 0 || rhs.min < min)
+                    min = rhs.min;
+                if (rhs.max > max)
+                    max = rhs.max;
+
+                count += rhs.count; total += rhs.total;
+
+                for (std::size_t i = 0; i < buckets; i++)
+                    counts[i] += rhs.counts[i];
+
+                return *this;
+            }
+
+            /**
+             * @return The mean latency in nanoseconds
+             */
+            double mean() const
+            {
+                return count ? double(total) / count : 0.0;
+            }
+
+            /**
+             * Get a latency percentile
+             *
+             * @param[in] p The percentile, from 0 to 100
+             *
+             * @return The latency in nanoseconds below which \a p
+             *         percent of calls fell
+             */
+            std::uint64_t percentile(double p) const
+            {
+                if (count == 0)
+                    return 0;
+
+                std::uint64_t target =
+                    static_cast<std::uint64_t>(p / 100.0 * count + 0.5);
+                if (target == 0)
+                    target = 1;
+
+                std::uint64_t seen = 0;
+                for (std::size_t i = 0; i < buckets; i++)
+                {
+                    seen += counts[i];
+                    if (seen >= target)
+                    {
+                        const std::uint64_t high = bucket_high(i);
+                        return high < max ? high : max;
+                    }
+                }
+
+                return max;
+            }
+
+            /**
+             * Print a one-line summary
+             *
+             * @param[in] os   The stream to print to
+             * @param[in] name A label for the line
+             */
+            void print(std::ostream& os, const char* name) const
+            {
+                os << name
+                   << ": calls="   << count
+                   << " mean="     << mean()           << "ns"
+                   << " min="      << min              << "ns"
+                   << " p50="      << percentile(50)   << "ns"
+                   << " p90="      << percentile(90)   << "ns"
+                   << " p99="      << percentile(99)   << "ns"
+                   << " p99.9="    << percentile(99.9) << "ns"
+                   << " max="      << max              << "ns"
+                   << "\n";
+            }
+
+            std::uint64_t count;
+            std::uint64_t max;
+            std::uint64_t min;
+            std::uint64_t total;
+
+            std::uint64_t counts[buckets];
+        };
+
+        /**
+         * Times a scope, recording its latency on destruction. Does
+         * nothing if given a null stats
+         */
+        class timer
+        {
+            typedef std::chrono::steady_clock clock;
+
+        public:
+
+            explicit timer(stats* s) : _start(), _stats(s)
+            {
+                if (_stats)
+                    _start = clock::now();
+            }
+
+            timer(const timer& other)            = delete;
+            timer& operator=(const timer& rhs)   = delete;
+
+            ~timer()
+            {
+                if (_stats)
+                {
+                    _stats->record(static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            clock::now() - _start).count()));
+                }
+            }
+
+        private:
+
+            clock::time_point _start;
+
+            stats* _stats;
+        };
+
+        /**
+         * Constructor
+         *
+         * @param[in] name A label for these stats, which must outlive
+         *                 them
+         */
+        explicit stats(const char* name = "")
+            : _name(name), _next(nullptr), _prev(nullptr)
+        {
+            reset();
+
+            std::lock_guard<std::mutex> lock(registry_lock());
+
+            _next = registry_head();
+            if (_next)
+                _next->_prev = this;
+            registry_head() = this;
+        }
+
+        stats(const stats& other)            = delete;
+        stats& operator=(const stats& rhs)   = delete;
+
+        /**
+         * Destructor
+         */
+        ~stats()
+        {
+            std::lock_guard<std::mutex> lock(registry_lock());
+
+            if (_prev)
+                _prev->_next = _next;
+            else
+                registry_head() = _next;
+
+            if (_next)
+                _next->_prev = _prev;
+        }
+
+        /**
+         * Sum the stats of every live stats object
+         *
+         * @return The combined summary
+         */
+        static summary aggregate()
+        {
+            std::lock_guard<std::mutex> lock(registry_lock());
+
+            summary total;
+            for (const stats* s = registry_head(); s; s = s->_next)
+                total += s->snapshot();
+
+            return total;
+        }
+
+        /**
+         * Map a latency to its histogram bucket
+         *
+         * @param[in] ns The latency in nanoseconds
+         *
+         * @return The bucket index
+         */
+        static std::size_t bucket_of(std::uint64_t ns)
+        {
+            if (ns < 8)
+                return static_cast<std::size_t>(ns);
+            if (ns >> 36)
+                return buckets - 1;
+
+            std::size_t m = 0;
+            std::uint64_t x = ns;
+
+            if (x >> 32) { x >>= 32; m += 32; }
+            if (x >> 16) { x >>= 16; m += 16; }
+            if (x >>  8) { x >>=  8; m +=  8; }
+            if (x >>  4) { x >>=  4; m +=  4; }
+            if (x >>  2) { x >>=  2; m +=  2; }
+            if (x >>  1) {           m +=  1; }
+
+            return (m - 2) * 8 + ((ns >> (m - 3)) & 7);
+        }
+
+        /**
+         * Get the largest latency that falls in a bucket
+         *
+         * @param[in] i The bucket index
+         *
+         * @return The latency in nanoseconds
+         */
+        static std::uint64_t bucket_high(std::size_t i)
+        {
+            if (i < 8)
+                return i;
+
+            const std::size_t m = i / 8 + 2;
+            return ((std::uint64_t(9 + i % 8)) << (m - 3)) - 1;
+        }
+
+        /**
+         * Print a line for every live stats object
+         *
+         * @param[in] os The stream to print to
+         */
+        static void dump_all(std::ostream& os)
+        {
+            std::lock_guard<std::mutex> lock(registry_lock());
+
+            for (const stats* s = registry_head(); s; s = s->_next)
+                s->snapshot().print(os, s->_name);
+        }
+
+        /**
+         * @return The label for these stats
+         */
+        const char* name() const
+        {
+            return _name;
+        }
+
+        /**
+         * Record one call
+         *
+         * @param[in] ns The latency of the call in nanoseconds
+         */
+        void record(std::uint64_t ns)
+        {
+            shard& s = _shards[this_shard()];
+
+            s.counts[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+            s.count.fetch_add(1, std::memory_order_relaxed);
+            s.total.fetch_add(ns, std::memory_order_relaxed);
+
+            std::uint64_t seen = s.max.load(std::memory_order_relaxed);
+            while (ns > seen && !s.max.compare_exchange_weak(seen, ns,
+                                    std::memory_order_relaxed))
+            {
+            }
+
+            seen = s.min.load(std::memory_order_relaxed);
+            while (ns < seen && !s.min.compare_exchange_weak(seen, ns,
+                                    std::memory_order_relaxed))
+            {
+            }
+        }
+
+        /**
+         * Clear all counts. Calls recorded concurrently with a reset
+         * may be partly lost
+         */
+        void reset()
+        {
+            for (std::size_t i = 0; i < shards; i++)
+            {
+                shard& s = _shards[i];
+
+                for (std::size_t j = 0; j < buckets; j++)
+                    s.counts[j].store(0, std::memory_order_relaxed);
+
+                s.count.store(0, std::memory_order_relaxed);
+                s.max.store(0, std::memory_order_relaxed);
+                s.min.store(std::numeric_limits<std::uint64_t>::max(),
+                            std::memory_order_relaxed);
+                s.total.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Sum the shards. Calls being recorded at the same time may be
+         * counted in some fields but not yet in others
+         *
+         * @return The summary
+         */
+        summary snapshot() const
+        {
+            summary total;
+
+            for (std::size_t i = 0; i < shards; i++)
+            {
+                const shard& s = _shards[i];
+
+                summary part;
+                part.count = s.count.load(std::memory_order_relaxed);
+                part.max   = s.max.load(std::memory_order_relaxed);
+                part.min   = s.min.load(std::memory_order_relaxed);
+                part.total = s.total.load(std::memory_order_relaxed);
+
+                for (std::size_t j = 0; j < buckets; j++)
+                {
+                    part.counts[j] =
+                        s.counts[j].load(std::memory_order_relaxed);
+                }
+
+                total += part;
+            }
+
+            return total;
+        }
+
+    private:
+
+        /*
+         * Padded by a cache line so that threads recording into
+         * neighboring shards do not contend
+         */
+        struct shard
+        {
+            std::atomic<std::uint64_t> counts[buckets];
+
+            std::atomic<std::uint64_t> count;
+            std::atomic<std::uint64_t> max;
+            std::atomic<std::uint64_t> min;
+            std::atomic<std::uint64_t> total;
+
+            unsigned char pad[64];
+        };
+
+        static std::mutex& registry_lock()
+        {
+            static std::mutex lock;
+            return lock;
+        }
+
+        static stats*& registry_head()
+        {
+            static stats* head = nullptr;
+            return head;
+        }
+
+        /*
+         * Threads are spread across the shards in the order in which
+         * they first record
+         */
+        static std::size_t this_shard()
+        {
+            static std::atomic<std::size_t> next(0);
+            static thread_local std::size_t index =
+                next.fetch_add(1, std::memory_order_relaxed) % shards;
+
+            return index;
+        }
+
+        const char* _name;
+
+        stats* _next;
+        stats* _prev;
+
+        shard _shards[shards];
+    };
+}
+
+#endif // __INSTRUMENT_H__
@@ -0,0 +1,1135 @@
+/**
+ *  \file   Multicast.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __MULTICAST_H__
+#define __MULTICAST_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "Signal.h"
+
+namespace Signal
+{
+    /**
+     ******************************************************************
+     *
+     * @class connection
+     *
+     * Identifies a single handler connected to a \ref Multicast. This
+     * is what you pass to Multicast::disconnect() to remove it. Each
+     * connection also records the signal that made it, so that it is
+     * never mistaken for a handler of another signal
+     *
+     ******************************************************************
+     */
+    class connection
+    {
+
+    public:
+
+        /**
+         * Default constructor. Creates a connection that refers to
+         * nothing
+         */
+        connection() : _id(0), _owner(0)
+        {
+        }
+
+        /**
+         * Constructor
+         *
+         * @param[in] owner The token of the signal the handler is
+         *                  connected to. See \ref new_owner()
+         * @param[in] id    The unique (per signal) ID of the handler
+         */
+        connection(std::uint64_t owner, std::uint64_t id)
+            : _id(id), _owner(owner)
+        {
+        }
+
+        /**
+         * @return The ID of the handler this connection refers to
+         */
+        std::uint64_t id() const
+        {
+            return _id;
+        }
+
+        /**
+         * @return True if this connection was returned by a connect()
+         */
+        bool is_valid() const
+        {
+            return _id != 0;
+        }
+
+        /**
+         * @return The token of the signal this connection was made by
+         */
+        std::uint64_t owner() const
+        {
+            return _owner;
+        }
+
+        /**
+         * Hand out a token that no other signal has. Signals give one
+         * to each connection they make, and ignore connections that do
+         * not carry theirs
+         *
+         * @return A new, nonzero token
+         */
+        static std::uint64_t new_owner()
+        {
+            static std::atomic<std::uint64_t> next(1);
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool operator==(const connection& rhs) const
+        {
+            return _id == rhs._id && _owner == rhs._owner;
+        }
+
+        bool operator!=(const connection& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+
+        std::uint64_t _id;
+        std::uint64_t _owner;
+    };
+
+    /**
+     ******************************************************************
+     *
+     * @class scoped_connection
+     *
+     * Owns a \ref connection, disconnecting the handler when it goes
+     * out of scope. Making one a member of the class whose method is
+     * the handler disconnects it when the object is destroyed:
+     *
+     * @code
+     * class Listener
+     * {
+     * public:
+     *     Listener(Signal::Multicast<void,int>& sig)
+     *         : _conn(sig, sig.connect(*this, &Listener::handle))
+     *     {
+     *     }
+     *
+     *     void handle(int value);
+     *
+     * private:
+     *     Signal::scoped_connection _conn;
+     * };
+     * @endcode
+     *
+     * This works with any signal that has a disconnect(connection)
+     * method, such as \ref Multicast and \ref ConcurrentMulticast
+     *
+     * @note The signal must outlive the scoped_connection, or the
+     *       connection must be release()d first
+     *
+     ******************************************************************
+     */
+    class scoped_connection
+    {
+
+    public:
+
+        /**
+         * Default constructor. Creates a scoped_connection that owns
+         * nothing
+         */
+        scoped_connection()
+            : _conn(), _disconnect(nullptr), _sig(nullptr)
+        {
+        }
+
+        /**
+         * Constructor
+         *
+         * @tparam S The type of signal
+         *
+         * @param[in] sig  The signal \a conn was returned by
+         * @param[in] conn The connection to take ownership of
+         */
+        template <class S>
+        scoped_connection(S& sig, const connection& conn)
+            : _conn(conn), _disconnect(&disconnect_from<S>), _sig(&sig)
+        {
+        }
+
+        scoped_connection(const scoped_connection& other)          = delete;
+        scoped_connection& operator=(const scoped_connection& rhs) = delete;
+
+        /**
+         * Move constructor
+         *
+         * @param[in] other The scoped_connection to take over. This
+         *                  leaves \a other owning nothing
+         */
+        scoped_connection(scoped_connection&& other) noexcept
+            : _conn(other._conn), _disconnect(other._disconnect),
+              _sig(other._sig)
+        {
+            other.release();
+        }
+
+        /**
+         * Destructor. Disconnects the handler
+         */
+        ~scoped_connection()
+        {
+            disconnect();
+        }
+
+        /**
+         * Move assignment operator. Disconnects the handler we own,
+         * if any, and takes over the one owned by \a rhs
+         *
+         * @param[in] rhs The scoped_connection to take over
+         *
+         * @return *this
+         */
+        scoped_connection& operator=(scoped_connection&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                disconnect();
+
+                _conn = rhs._conn; _disconnect = rhs._disconnect;
+                _sig  = rhs._sig;
+
+                rhs.release();
+            }
+
+            return *this;
+        }
+
+        /**
+         * Disconnect the handler now
+         *
+         * @return True if a handler was disconnected
+         */
+        bool disconnect()
+        {
+            const bool disconnected = _sig && _disconnect(_sig, _conn);
+
+            release();
+            return disconnected;
+        }
+
+        /**
+         * @return The connection we own
+         */
+        connection get() const
+        {
+            return _conn;
+        }
+
+        /**
+         * Give up ownership without disconnecting the handler
+         *
+         * @return The connection we owned
+         */
+        connection release()
+        {
+            const connection conn = _conn;
+
+            _conn = connection(); _disconnect = nullptr;
+            _sig  = nullptr;
+
+            return conn;
+        }
+
+    private:
+
+        template <class S>
+        static bool disconnect_from(void* sig, const connection& conn)
+        {
+            return static_cast<S*>(sig)->disconnect(conn);
+        }
+
+        connection _conn;
+
+        bool (*_disconnect)(void*, const connection&);
+
+        void* _sig;
+    };
+
+    /**
+     ******************************************************************
+     *
+     * Combiners for Multicast::raise_with(). A combiner is called with
+     * the return value of each handler in turn, and returns false to
+     * stop the remaining handlers from being invoked. Its result()
+     * is then returned by raise_with(). Use a new combiner for each
+     * raise
+     *
+     ******************************************************************
+     */
+
+    /**
+     * Stops at the first handler that returns false
+     */
+    class first_false
+    {
+
+    public:
+
+        typedef bool result_type;
+
+        first_false() : _result(true)
+        {
+        }
+
+        bool operator()(bool value)
+        {
+            _result = value;
+            return value;
+        }
+
+        /**
+         * @return True if every handler returned true
+         */
+        bool result() const
+        {
+            return _result;
+        }
+
+    private:
+
+        bool _result;
+    };
+
+    /**
+     * Adds up the handlers' return values
+     *
+     * @tparam T The type of the sum
+     */
+    template <class T>
+    class sum
+    {
+
+    public:
+
+        typedef T result_type;
+
+        sum() : _total()
+        {
+        }
+
+        template <class V>
+        bool operator()(const V& value)
+        {
+            _total += value;
+            return true;
+        }
+
+        /**
+         * @return The sum, or T() if there were no handlers
+         */
+        T result() const
+        {
+            return _total;
+        }
+
+    private:
+
+        T _total;
+    };
+
+    /**
+     * Finds the largest of the handlers' return values
+     *
+     * @tparam T The type of the return values
+     */
+    template <class T>
+    class maximum
+    {
+
+    public:
+
+        typedef T result_type;
+
+        maximum() : _any(false), _max()
+        {
+        }
+
+        bool operator()(const T& value)
+        {
+            if (!_any || _max < value)
+                _max = value;
+
+            _any = true;
+            return true;
+        }
+
+        /**
+         * @return True if no handler was invoked
+         */
+        bool empty() const
+        {
+            return !_any;
+        }
+
+        /**
+         * @return The largest value, or T() if there were no handlers
+         */
+        T result() const
+        {
+            return _max;
+        }
+
+    private:
+
+        bool _any;
+        T    _max;
+    };
+
+    /**
+     * Copies the handlers' return values into a caller-provided array.
+     * Once the array is full, no further handlers are invoked
+     *
+     * @tparam T The type of the return values
+     */
+    template <class T>
+    class collect
+    {
+
+    public:
+
+        typedef std::size_t result_type;
+
+        /**
+         * Constructor
+         *
+         * @param[in] buf      The array to store return values in
+         * @param[in] capacity The number of elements in \a buf
+         */
+        collect(T* buf, std::size_t capacity)
+            : _buf(buf), _capacity(capacity), _count(0)
+        {
+        }
+
+        bool operator()(const T& value)
+        {
+            if (_count < _capacity)
+                _buf[_count++] = value;
+
+            return _count < _capacity;
+        }
+
+        /**
+         * @return The number of values stored
+         */
+        std::size_t result() const
+        {
+            return _count;
+        }
+
+    private:
+
+        T* _buf;
+        std::size_t _capacity;
+        std::size_t _count;
+    };
+
+#ifndef DOXYGEN_SKIP
+    /*
+     * Every handler of a multicast is given the same arguments, so any
+     * taken by value are passed along by const reference and only copied
+     * into each handler's own parameter
+     */
+    template <class A>
+    struct slot_arg
+    {
+        typedef typename std::conditional<std::is_reference<A>::value, A,
+            const A&>::type type;
+    };
+
+    /*
+     * A single multicast handler. This holds the object (if any) on
+     * which to invoke the handler, the raw bytes of the function or
+     * member function pointer, and a thunk that puts the two back
+     * together. It is trivially copyable, so a vector of slots is just
+     * a flat array
+     */
+    template <class R, class... A>
+    struct slot
+    {
+        using thunk_t = R(*)(const slot<R,A...>&,
+                             typename slot_arg<A>::type...);
+
+        using func_storage = unsigned char[sizeof(void(generic::*)())];
+
+        void*   obj;
+        thunk_t thunk;
+
+        alignas(void(generic::*)()) func_storage func;
+
+        template <class F>
+        void set(void* target, F f, thunk_t fn)
+        {
+            static_assert(sizeof(F) <= sizeof(func_storage),
+                          "Handler does not fit in a slot");
+
+            obj = target; thunk = fn;
+            std::memcpy(func, &f, sizeof(F));
+        }
+
+        template <class F>
+        F get() const
+        {
+            F f;
+            std::memcpy(&f, func, sizeof(F));
+            return f;
+        }
+
+        static R call(const slot<R,A...>& s,
+                      typename slot_arg<A>::type... args)
+        {
+            return s.template get<R(*)(A...)>()(args...);
+        }
+
+        template <class C, class F>
+        static R call_mem(const slot<R,A...>& s,
+                          typename slot_arg<A>::type... args)
+        {
+            return (static_cast<C*>(s.obj)->*s.template get<F>())(
+                args...);
+        }
+    };
+#endif
+
+    /**
+     ******************************************************************
+     *
+     * @class Multicast
+     *
+     * A signal that may have any number of handlers, each of which is
+     * invoked (in the order in which they were connected) when the
+     * signal is raised. Handlers may be function pointers or class
+     * methods, and are kept in a contiguous array so that raising the
+     * signal is a tight loop over its subscribers
+     *
+     * Handlers may also be connected with a priority. Those with a
+     * higher priority are invoked first, and handlers of the same
+     * priority in the order in which they were connected. Handlers
+     * are kept sorted as they are connected, so raising the signal
+     * never sorts. The default priority is 0
+     *
+     * A connection holds the index of its handler's entry in a table
+     * and a generation count for that entry, so disconnecting takes
+     * constant time. The handler is only marked as disconnected; the
+     * array of handlers is compacted once at least half of them are
+     * disconnected, and never while the signal is being raised
+     *
+     * @note Handlers may disconnect any handler of the Multicast that
+     *       is invoking them, including themselves, but must not
+     *       connect new ones
+     *
+     * @tparam R  The handlers' return type. Return values are ignored
+     * @tparam A  Specifies the type(s) of input arguments required by
+     *            the handlers
+     *
+     ******************************************************************
+     */
+    template <class R, class... A>
+    class Multicast : public generic
+    {
+        using slot_type = slot<R,A...>;
+
+        static_assert(std::is_trivially_copyable<slot_type>::value,
+                      "Slots must be trivially copyable");
+
+    public:
+
+        /**
+         * Default constructor
+         */
+        Multicast() : _dead(0), _emitting(0), _entries(), _free(),
+                      _owner(connection::new_owner()), _owners(),
+                      _priorities(), _sargs(), _slots()
+        {
+        }
+
+        /**
+         * Copy constructor. The copy has the same handlers as \a other,
+         * but connections made by \a other do not refer to them
+         *
+         * @param [in] other The Multicast of which *this will be a copy
+         */
+        Multicast(const Multicast<R,A...>& other)
+            : generic(other), _dead(other._dead), _emitting(0),
+              _entries(other._entries), _free(other._free),
+              _owner(connection::new_owner()), _owners(other._owners),
+              _priorities(other._priorities), _sargs(other._sargs),
+              _slots(other._slots)
+        {
+        }
+
+        /**
+         * Destructor
+         */
+        virtual ~Multicast()
+        {
+        }
+
+        /**
+         * Copy assignment operator. Connections made by *this before
+         * the assignment no longer refer to any of its handlers
+         *
+         * @param [in] rhs The Multicast to copy
+         *
+         * @return *this
+         */
+        Multicast<R,A...>& operator=(const Multicast<R,A...>& rhs)
+        {
+            if (this != &rhs)
+            {
+                _dead       = rhs._dead;
+                _entries    = rhs._entries;
+                _free       = rhs._free;
+                _owner      = connection::new_owner();
+                _owners     = rhs._owners;
+                _priorities = rhs._priorities;
+                _sargs      = rhs._sargs;
+                _slots      = rhs._slots;
+            }
+
+            return *this;
+        }
+
+        /**
+         * A factory method that creates a copy of this object
+         *
+         * @return A \ref generic pointer to the newly created
+         *         object
+         */
+        generic* clone() const
+        {
+            return new Multicast<R,A...>(*this);
+        }
+
+        /**
+         * A factory method that creates a copy of this object in memory
+         * drawn from \a mem. Only the Multicast itself is placed there;
+         * its handler list is still allocated from the heap
+         *
+         * @param[in] mem The arena from which to allocate the copy
+         *
+         * @return A \ref generic pointer to the newly created
+         *         object
+         */
+        generic* clone(arena& mem) const
+        {
+            return clone_in(mem, *this);
+        }
+
+        /**
+         * Bind arguments to the signal handlers. This avoids having
+         * to call raise() with explicit inputs
+         *
+         * @note This creates internal copies of \a args to pass to
+         *       the signal handlers, moving any that are given as
+         *       rvalues. See \ref forward() if you wish to forward
+         *       references instead
+         *
+         * @param[in] args Input arguments to implicitly forward
+         *                 to the handlers
+         */
+        void bind(A... args)
+        {
+            _sargs.bind(std::forward<A>(args)...);
+        }
+
+        /**
+         * Connect a handler which is a C-style function pointer
+         *
+         * @param[in] func The handler
+         *
+         * @return The new connection, which is invalid if \a func is
+         *         null
+         */
+        connection connect(R(*func)(A...))
+        {
+            return connect(0, func);
+        }
+
+        /**
+         * Connect a handler which is a C-style function pointer, with
+         * a priority
+         *
+         * @param[in] priority Handlers of higher priority are invoked
+         *                     first
+         * @param[in] func     The handler
+         *
+         * @return The new connection, which is invalid if \a func is
+         *         null
+         */
+        connection connect(int priority, R(*func)(A...))
+        {
+            if (func == nullptr)
+                return connection();
+
+            slot_type s;
+            s.set(nullptr, func, &slot_type::call);
+
+            return add(s, priority);
+        }
+
+        /**
+         * Connect a handler which is a member of class C
+         *
+         * @tparam C Class that implements the handler
+         *
+         * @param[in] obj  Object (of class C) through which to invoke
+         *                 the handler
+         * @param[in] func A pointer to the handler
+         *
+         * @return The new connection, which is invalid if \a func is
+         *         null
+         */
+        template <typename C>
+        connection connect(C& obj, R(C::*func)(A...))
+        {
+            return connect(0, obj, func);
+        }
+
+        /**
+         * Connect a handler which is a member of class C, with a
+         * priority
+         *
+         * @tparam C Class that implements the handler
+         *
+         * @param[in] priority Handlers of higher priority are invoked
+         *                     first
+         * @param[in] obj      Object (of class C) through which to
+         *                     invoke the handler
+         * @param[in] func     A pointer to the handler
+         *
+         * @return The new connection, which is invalid if \a func is
+         *         null
+         */
+        template <typename C>
+        connection connect(int priority, C& obj, R(C::*func)(A...))
+        {
+            using F = R(C::*)(A...);
+
+            if (func == nullptr)
+                return connection();
+
+            slot_type s;
+            s.set(&obj, func,
+                  &slot_type::template call_mem<C,F>);
+
+            return add(s, priority);
+        }
+
+        /**
+         * Connect a handler which is a *const* member of class C
+         *
+         * @tparam C Class that implements the handler
+         *
+         * @param[in] obj  Object (of class C) through which to invoke
+         *                 the handler
+         * @param[in] func A pointer to the *const* handler
+         *
+         * @return The new connection, which is invalid if \a func is
+         *         null
+         */
+        template <typename C>
+        connection connect(const C& obj, R(C::*func)(A...) const)
+        {
+            return connect(0, obj, func);
+        }
+
+        /**
+         * Connect a handler which is a *const* member of class C, with
+         * a priority
+         *
+         * @tparam C Class that implements the handler
+         *
+         * @param[in] priority Handlers of higher priority are invoked
+         *                     first
+         * @param[in] obj      Object (of class C) through which to
+         *                     invoke the handler
+         * @param[in] func     A pointer to the *const* handler
+         *
+         * @return The new connection, which is invalid if \a func is
+         *         null
+         */
+        template <typename C>
+        connection connect(int priority, const C& obj,
+                           R(C::*func)(A...) const)
+        {
+            using F = R(C::*)(A...) const;
+
+            if (func == nullptr)
+                return connection();
+
+            slot_type s;
+            s.set(const_cast<C*>(&obj), func,
+                  &slot_type::template call_mem<const C,F>);
+
+            return add(s, priority);
+        }
+
+        /**
+         * Disconnect a handler
+         *
+         * @param[in] conn The connection returned when the handler was
+         *                 connected
+         *
+         * @return True on success, or false if \a conn does not refer
+         *         to a handler of this signal
+         */
+        bool disconnect(const connection& conn)
+        {
+            const entry* e = find(conn);
+            if (e == nullptr)
+                return false;
+
+            remove(e - _entries.data());
+
+            if (_emitting == 0 && 2 * _dead > _slots.size())
+                compact();
+
+            return true;
+        }
+
+        /**
+         * Disconnect all handlers
+         */
+        void disconnect_all()
+        {
+            for (std::size_t i = 0; i < _slots.size(); i++)
+            {
+                if (_slots[i].thunk)
+                    remove(_owners[i]);
+            }
+
+            if (_emitting == 0)
+                compact();
+        }
+
+        /**
+         * Forward arguments to the signal handlers. Unlike \ref bind(),
+         * which forwards copies, this will forward \a args by
+         * reference, e.g. in case they need to be modified within the
+         * signal handlers
+         *
+         * @warning
+         * Forwarding references may lead to undefined behavior if you
+         * allow \a args to go out of scope
+         *
+         * @param[in] args Input arguments to implicitly forward
+         */
+        void forward(typename std::remove_reference<A>::type&... args)
+        {
+            _sargs.forward(args...);
+        }
+
+        /**
+         * Check whether any handlers are connected to this signal
+         *
+         * @return True if at least one handler is connected
+         */
+        bool is_connected() const
+        {
+            return size() != 0;
+        }
+
+        /**
+         * Check whether a particular handler is connected
+         *
+         * @param[in] conn The connection returned when the handler was
+         *                 connected
+         *
+         * @return True if the handler is still connected
+         */
+        bool is_connected(const connection& conn) const
+        {
+            return find(conn) != nullptr;
+        }
+
+        /**
+         * Invoke each of the signal handlers, in the order in which
+         * they were connected
+         *
+         * @param[in] args The input arguments to provide the handlers
+         *                 with
+         */
+        void raise(typename slot_arg<A>::type... args) const
+        {
+            const emission guard(*this);
+
+            const slot_type* s   = _slots.data();
+            const slot_type* end = s + _slots.size();
+
+            for (; s != end; ++s)
+            {
+                if (s->thunk)
+                    s->thunk(*s, args...);
+            }
+        }
+
+        /**
+         * Invoke the signal handlers in order, passing each one's
+         * return value to a combiner, until the combiner says to stop.
+         * See \ref first_false, \ref sum, \ref maximum and \ref
+         * collect
+         *
+         * @param[in] combiner Receives each handler's return value
+         * @param[in] args     The input arguments to provide the
+         *                     handlers with
+         *
+         * @return The combiner's result
+         */
+        template <class Combiner>
+        typename Combiner::result_type raise_with(Combiner& combiner,
+            typename slot_arg<A>::type... args) const
+        {
+            const emission guard(*this);
+
+            const slot_type* s   = _slots.data();
+            const slot_type* end = s + _slots.size();
+
+            for (; s != end; ++s)
+            {
+                if (s->thunk && !combiner(s->thunk(*s, args...)))
+                    break;
+            }
+
+            return combiner.result();
+        }
+
+        /**
+         * Forward bound arguments to the signal handlers
+         */
+        template <int N=0>
+        void raise()
+        {
+            run(typename gens<sizeof...(A)>::type());
+        }
+
+        /**
+         * Reserve space for \a n handlers, so that connecting up to
+         * that many does not reallocate
+         *
+         * @param[in] n The number of handlers to reserve space for
+         */
+        void reserve(std::size_t n)
+        {
+            _owners.reserve(n); _priorities.reserve(n); _slots.reserve(n);
+        }
+
+        /**
+         * @return The number of connected handlers
+         */
+        std::size_t size() const
+        {
+            return _slots.size() - _dead;
+        }
+
+        /**
+         * Forward bound arguments to the signal handlers
+         *
+         * This is equivalent to \ref raise() except that it can be
+         * invoked through a \ref generic
+         */
+        void v_raise()
+        {
+            raise();
+        }
+
+    private:
+
+        /*
+         * Where a connection's handler is in the array of slots. The
+         * generation changes each time the handler is disconnected, so
+         * that stale connections no longer match. An entry whose
+         * generation reaches its maximum is retired rather than reused,
+         * so the generation never wraps around
+         */
+        struct entry
+        {
+            std::uint32_t generation;
+            std::uint32_t position;
+        };
+
+        /*
+         * Counts the raises underway, so that we know not to compact
+         * the slots out from under them
+         */
+        class emission
+        {
+
+        public:
+
+            explicit emission(const Multicast<R,A...>& sig) : _sig(sig)
+            {
+                _sig._emitting++;
+            }
+
+            ~emission()
+            {
+                _sig._emitting--;
+            }
+
+        private:
+
+            const Multicast<R,A...>& _sig;
+        };
+
+        /*
+         * Insert a handler after every other of the same or higher
+         * priority. Searching from the back keeps connecting handlers
+         * of equal priority constant time
+         */
+        connection add(const slot_type& s, int priority)
+        {
+            std::uint32_t index;
+            if (_free.empty())
+            {
+                index = static_cast<std::uint32_t>(_entries.size());
+
+                const entry e = { 1, 0 };
+                _entries.push_back(e);
+            }
+            else
+            {
+                index = _free.back(); _free.pop_back();
+            }
+
+            std::size_t i = _priorities.size();
+            while (i > 0 && _priorities[i-1] < priority)
+                i--;
+
+            _slots.insert(_slots.begin() + i, s);
+            _owners.insert(_owners.begin() + i, index);
+            _priorities.insert(_priorities.begin() + i, priority);
+
+            for (std::size_t j = i; j < _slots.size(); j++)
+            {
+                if (_slots[j].thunk)
+                    _entries[_owners[j]].position =
+                        static_cast<std::uint32_t>(j);
+            }
+
+            return connection(_owner,
+                (std::uint64_t(_entries[index].generation) << 32)
+                    | (index + 1));
+        }
+
+        /*
+         * Drop disconnected slots, keeping the rest in order
+         */
+        void compact()
+        {
+            std::size_t n = 0;
+
+            for (std::size_t i = 0; i < _slots.size(); i++)
+            {
+                if (_slots[i].thunk == nullptr)
+                    continue;
+
+                _slots[n]      = _slots[i];
+                _owners[n]     = _owners[i];
+                _priorities[n] = _priorities[i];
+
+                _entries[_owners[n]].position =
+                    static_cast<std::uint32_t>(n);
+                n++;
+            }
+
+            _slots.resize(n); _owners.resize(n); _priorities.resize(n);
+            _dead = 0;
+        }
+
+        /*
+         * Look up the entry for a connection, or return null if it is
+         * not one of ours or is no longer connected
+         */
+        const entry* find(const connection& conn) const
+        {
+            const std::uint64_t index = (conn.id() & 0xffffffff) - 1;
+
+            if (conn.owner() != _owner || index >= _entries.size() ||
+                _entries[index].generation != (conn.id() >> 32))
+            {
+                return nullptr;
+            }
+
+            return &_entries[index];
+        }
+
+        /*
+         * Mark a handler as disconnected and recycle its entry
+         */
+        void remove(std::size_t index)
+        {
+            entry& e = _entries[index];
+
+            _slots[e.position].thunk = nullptr;
+            e.generation++;
+
+            if (e.generation != UINT32_MAX)
+                _free.push_back(static_cast<std::uint32_t>(index));
+            _dead++;
+        }
+
+        template<int... S>
+        void run(seq<S...>)
+        {
+            if (_sargs.has_refs())
+                raise(*std::get<S>(_sargs.ptrs())... );
+            else
+                raise( std::get<S>(_sargs.args())... );
+        }
+
+        std::size_t _dead;
+
+        mutable std::size_t _emitting;
+
+        std::vector<entry>
+            _entries;
+
+        std::vector<std::uint32_t>
+            _free;
+
+        /*
+         * The token carried by every connection this signal makes
+         */
+        std::uint64_t _owner;
+
+        /*
+         * The index of each slot's entry
+         */
+        std::vector<std::uint32_t>
+            _owners;
+
+        std::vector<int>
+            _priorities;
+
+        SignalArgs< A... >
+            _sargs;
+
+        std::vector<slot_type>
+            _slots;
+    };
+}
+
+#endif // __MULTICAST_H__
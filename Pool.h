@@ -0,0 +1,183 @@
+/**
+ *  \file   Pool.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "Signal.h"
+
+namespace Signal
+{
+    /**
+     ******************************************************************
+     *
+     * @class pool
+     *
+     * An \ref arena that hands out blocks of a single, fixed size. The
+     * blocks are carved out of large chunks, so cloning thousands of
+     * signals into a pool costs a handful of heap allocations rather
+     * than one per signal. Blocks may be returned individually with
+     * deallocate(), or all at once with reset()
+     *
+     * For example:
+     *
+     * @code
+     * Signal::pool mem(sizeof(Signal::Signal<void,int>));
+     *
+     * Signal::generic* copy = sig.clone(mem);
+     * copy->v_raise();
+     * Signal::dispose(copy, mem);
+     * @endcode
+     *
+     * @note A pool is not thread-safe
+     *
+     ******************************************************************
+     */
+    class pool : public arena
+    {
+        /*
+         * A free block holds a link to the next one
+         */
+        struct free_block
+        {
+            free_block* next;
+        };
+
+    public:
+
+        /**
+         * Constructor
+         *
+         * @param[in] block_size   The size of each block. This must be
+         *                         at least the size of the largest
+         *                         signal to be cloned into the pool
+         * @param[in] chunk_blocks The number of blocks to reserve from
+         *                         the heap at a time
+         */
+        explicit pool(std::size_t block_size, std::size_t chunk_blocks = 64)
+            : _block_size(round_up(block_size)), _chunk(0),
+              _chunk_blocks(chunk_blocks ? chunk_blocks : 1), _chunks(),
+              _free(nullptr), _next(0)
+        {
+        }
+
+        pool(const pool& other)            = delete;
+        pool& operator=(const pool& rhs)   = delete;
+
+        /**
+         * Destructor. Returns every chunk to the heap. No destructors
+         * are run for objects still in the pool
+         */
+        ~pool()
+        {
+            for (std::size_t i = 0; i < _chunks.size(); i++)
+                ::operator delete(_chunks[i]);
+        }
+
+        /**
+         * Allocate a block
+         *
+         * @param[in] size  The number of bytes required, which may not
+         *                  exceed block_size()
+         * @param[in] align The required alignment, which may not exceed
+         *                  that of std::max_align_t
+         *
+         * @return The block
+         */
+        void* allocate(std::size_t size, std::size_t align)
+        {
+            if (size > _block_size || align > alignof(std::max_align_t))
+                throw std::bad_alloc();
+
+            if (_free)
+            {
+                free_block* block = _free;
+                _free = block->next;
+                return block;
+            }
+
+            if (_next == _chunk_blocks)
+            {
+                _chunk++; _next = 0;
+            }
+
+            if (_chunk == _chunks.size())
+            {
+                _chunks.push_back(
+                    ::operator new(_block_size * _chunk_blocks));
+            }
+
+            return static_cast<unsigned char*>(_chunks[_chunk])
+                + _block_size * _next++;
+        }
+
+        /**
+         * @return The size of each block
+         */
+        std::size_t block_size() const
+        {
+            return _block_size;
+        }
+
+        /**
+         * Return a block to the pool
+         *
+         * @param[in] ptr The block, which was obtained from allocate()
+         */
+        void deallocate(void* ptr)
+        {
+            free_block* block = static_cast<free_block*>(ptr);
+
+            block->next = _free;
+            _free = block;
+        }
+
+        /**
+         * Return every block to the pool at once. The chunks are kept
+         * for reuse
+         *
+         * @warning No destructors are run, so this must only be called
+         *          once the objects in the pool have been destroyed, or
+         *          if they do not need destroying
+         */
+        void reset()
+        {
+            _chunk = 0; _free = nullptr; _next = 0;
+        }
+
+    private:
+
+        static std::size_t round_up(std::size_t size)
+        {
+            const std::size_t align = alignof(std::max_align_t);
+
+            if (size < sizeof(free_block))
+                size = sizeof(free_block);
+
+            return (size + align - 1) / align * align;
+        }
+
+        const std::size_t _block_size;
+
+        std::size_t _chunk;
+
+        const std::size_t _chunk_blocks;
+
+        std::vector<void*>
+            _chunks;
+
+        free_block* _free;
+
+        std::size_t _next;
+    };
+}
+
+#endif // __POOL_H__
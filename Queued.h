@@ -0,0 +1,766 @@
+/**
+ *  \file   Queued.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __QUEUED_H__
+#define __QUEUED_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Signal.h"
+
+namespace Signal
+{
+    /**
+     * What a \ref Dispatcher does when a task is posted to it while its
+     * queue is full
+     */
+    enum class overflow
+    {
+        block,       /**< Wait for room in the queue */
+        drop_newest, /**< Discard the task being posted */
+        drop_oldest  /**< Discard the oldest queued task to make room */
+    };
+
+#ifndef DOXYGEN_SKIP
+    /*
+     * A bounded multi-producer, multi-consumer queue. Each cell carries
+     * a sequence number telling producers and consumers whose turn it
+     * is, so pushing and popping each take one CAS on their respective
+     * position and never a lock:
+     *
+     * http://www.1024cores.net/home/lock-free-algorithms/queues/
+     *         bounded-mpmc-queue
+     */
+    template <class T>
+    class bounded_queue
+    {
+        struct cell
+        {
+            std::atomic<std::size_t> seq;
+
+            alignas(T) unsigned char data[sizeof(T)];
+        };
+
+    public:
+
+        explicit bounded_queue(std::size_t capacity)
+            : _cells(), _dequeue_pos(0), _enqueue_pos(0), _mask(0)
+        {
+            std::size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+
+            _cells.reset(new cell[size]);
+            _mask = size - 1;
+
+            for (std::size_t i = 0; i < size; i++)
+                _cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+
+        ~bounded_queue()
+        {
+            T item;
+            while (try_pop(item))
+            {
+            }
+        }
+
+        std::size_t capacity() const
+        {
+            return _mask + 1;
+        }
+
+        bool empty() const
+        {
+            return _enqueue_pos.load() == _dequeue_pos.load();
+        }
+
+        bool try_push(T&& item)
+        {
+            std::size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+            cell* c;
+
+            for (;;)
+            {
+                c = &_cells[pos & _mask];
+
+                const std::size_t seq =
+                    c->seq.load(std::memory_order_acquire);
+                const std::intptr_t dif =
+                    std::intptr_t(seq) - std::intptr_t(pos);
+
+                if (dif == 0)
+                {
+                    /*
+                     * This is seq_cst (rather than relaxed) so callers
+                     * can order it against a later seq_cst load
+                     */
+                    if (_enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                            std::memory_order_seq_cst,
+                            std::memory_order_relaxed))
+                        break;
+                }
+                else if (dif < 0)
+                    return false;
+                else
+                    pos = _enqueue_pos.load(std::memory_order_relaxed);
+            }
+
+            ::new (static_cast<void*>(c->data)) T(std::move(item));
+            c->seq.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        bool try_pop(T& item)
+        {
+            std::size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+            cell* c;
+
+            for (;;)
+            {
+                c = &_cells[pos & _mask];
+
+                const std::size_t seq =
+                    c->seq.load(std::memory_order_acquire);
+                const std::intptr_t dif =
+                    std::intptr_t(seq) - std::intptr_t(pos + 1);
+
+                if (dif == 0)
+                {
+                    if (_dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                            std::memory_order_relaxed))
+                        break;
+                }
+                else if (dif < 0)
+                    return false;
+                else
+                    pos = _dequeue_pos.load(std::memory_order_relaxed);
+            }
+
+            T* data = reinterpret_cast<T*>(c->data);
+
+            item = std::move(*data);
+            data->~T();
+
+            c->seq.store(pos + _mask + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+
+        std::unique_ptr<cell[]>
+            _cells;
+
+        alignas(64) std::atomic<std::size_t>
+            _dequeue_pos;
+        alignas(64) std::atomic<std::size_t>
+            _enqueue_pos;
+
+        std::size_t _mask;
+    };
+#endif
+
+    /**
+     ******************************************************************
+     *
+     * @class task
+     *
+     * A move-only, type-erased nullary callable. Callables of up to
+     * \ref capacity bytes that can be moved without throwing are stored
+     * inline; others are moved to the heap. Moving a task therefore
+     * never throws
+     *
+     ******************************************************************
+     */
+    class task
+    {
+        struct ops
+        {
+            void (*invoke)(void*);
+            void (*move)(void* dst, void* src);
+            void (*destroy)(void*);
+        };
+
+        template <class F>
+        struct inline_ops
+        {
+            static void invoke(void* p)
+            {
+                (*static_cast<F*>(p))();
+            }
+
+            static void move(void* dst, void* src) noexcept
+            {
+                ::new (dst) F(std::move(*static_cast<F*>(src)));
+                static_cast<F*>(src)->~F();
+            }
+
+            static void destroy(void* p)
+            {
+                static_cast<F*>(p)->~F();
+            }
+
+            static const ops table;
+        };
+
+        template <class F>
+        struct heap_ops
+        {
+            static void invoke(void* p)
+            {
+                (**static_cast<F**>(p))();
+            }
+
+            static void move(void* dst, void* src) noexcept
+            {
+                *static_cast<F**>(dst) = *static_cast<F**>(src);
+            }
+
+            static void destroy(void* p)
+            {
+                delete *static_cast<F**>(p);
+            }
+
+            static const ops table;
+        };
+
+    public:
+
+        /**
+         * The maximum size of a callable that is stored inline
+         */
+        static const std::size_t capacity = 48;
+
+        /**
+         * Default constructor. Creates an empty task
+         */
+        task() : _ops(nullptr)
+        {
+        }
+
+        /**
+         * Constructor
+         *
+         * @param[in] func The callable to wrap
+         */
+        template <class F, class = typename std::enable_if<
+            !std::is_same<typename std::decay<F>::type, task>::value
+                >::type>
+        explicit task(F&& func) : _ops(nullptr)
+        {
+            using T = typename std::decay<F>::type;
+
+            if (sizeof(T) <= capacity &&
+                alignof(T) <= alignof(std::max_align_t) &&
+                std::is_nothrow_move_constructible<T>::value)
+            {
+                ::new (static_cast<void*>(_storage))
+                    T(std::forward<F>(func));
+                _ops = &inline_ops<T>::table;
+            }
+            else
+            {
+                *reinterpret_cast<T**>(_storage) =
+                    new T(std::forward<F>(func));
+                _ops = &heap_ops<T>::table;
+            }
+        }
+
+        /**
+         * Move constructor
+         *
+         * @param[in] other The task to move into *this. This leaves
+         *                  \a other empty
+         */
+        task(task&& other) noexcept : _ops(other._ops)
+        {
+            if (_ops)
+            {
+                _ops->move(_storage, other._storage);
+                other._ops = nullptr;
+            }
+        }
+
+        task(const task& other) = delete;
+        task& operator=(const task& rhs) = delete;
+
+        /**
+         * Destructor
+         */
+        ~task()
+        {
+            reset();
+        }
+
+        /**
+         * Move assignment operator
+         *
+         * @param[in] rhs The task to move into *this. This leaves
+         *                \a rhs empty
+         *
+         * @return *this
+         */
+        task& operator=(task&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                reset();
+
+                if (rhs._ops)
+                {
+                    rhs._ops->move(_storage, rhs._storage);
+                    _ops = rhs._ops; rhs._ops = nullptr;
+                }
+            }
+
+            return *this;
+        }
+
+        /**
+         * @return True if this task wraps a callable
+         */
+        explicit operator bool() const
+        {
+            return _ops != nullptr;
+        }
+
+        /**
+         * Invoke the wrapped callable
+         */
+        void operator()()
+        {
+            _ops->invoke(_storage);
+        }
+
+    private:
+
+        void reset()
+        {
+            if (_ops)
+            {
+                _ops->destroy(_storage);
+                _ops = nullptr;
+            }
+        }
+
+        const ops* _ops;
+
+        alignas(std::max_align_t) unsigned char
+            _storage[capacity];
+    };
+
+#ifndef DOXYGEN_SKIP
+    template <class F>
+    const task::ops task::inline_ops<F>::table = {
+        &task::inline_ops<F>::invoke,
+        &task::inline_ops<F>::move,
+        &task::inline_ops<F>::destroy
+    };
+
+    template <class F>
+    const task::ops task::heap_ops<F>::table = {
+        &task::heap_ops<F>::invoke,
+        &task::heap_ops<F>::move,
+        &task::heap_ops<F>::destroy
+    };
+#endif
+
+    /**
+     ******************************************************************
+     *
+     * @class Dispatcher
+     *
+     * A pool of worker threads that run \ref task "tasks" posted to a
+     * bounded, lock-free queue. Workers that find the queue empty spin
+     * briefly and then sleep until more work is posted
+     *
+     ******************************************************************
+     */
+    class Dispatcher
+    {
+
+    public:
+
+        /**
+         * Constructor
+         *
+         * @param[in] threads  The number of worker threads
+         * @param[in] capacity The maximum number of queued tasks. This
+         *                     is rounded up to a power of two
+         * @param[in] policy   What to do when posting to a full queue
+         */
+        Dispatcher(std::size_t threads, std::size_t capacity,
+                   overflow policy = overflow::block)
+            : _dropped(0), _lock(), _pending(0), _policy(policy),
+              _queue(capacity), _sleepers(0), _stop(false), _wakeup(),
+              _workers()
+        {
+            for (std::size_t i = 0; i < threads; i++)
+                _workers.emplace_back(&Dispatcher::work, this);
+        }
+
+        Dispatcher(const Dispatcher& other) = delete;
+        Dispatcher& operator=(const Dispatcher& rhs) = delete;
+
+        /**
+         * Destructor. Runs any tasks still queued and then joins the
+         * worker threads
+         */
+        ~Dispatcher()
+        {
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                _stop.store(true);
+            }
+
+            _wakeup.notify_all();
+
+            for (auto& worker : _workers)
+                worker.join();
+        }
+
+        /**
+         * @return The queue capacity
+         */
+        std::size_t capacity() const
+        {
+            return _queue.capacity();
+        }
+
+        /**
+         * Wait until every task posted so far has either run or been
+         * dropped
+         */
+        void drain()
+        {
+            while (_pending.load() != 0)
+                std::this_thread::yield();
+        }
+
+        /**
+         * @return The number of tasks dropped due to a full queue
+         */
+        std::size_t dropped() const
+        {
+            return _dropped.load();
+        }
+
+        /**
+         * Queue a task to be run by one of the workers
+         *
+         * @param[in] item The task to run
+         *
+         * @return True if \a item was queued, or false if it was dropped
+         */
+        bool post(task&& item)
+        {
+            _pending.fetch_add(1);
+
+            while (!_queue.try_push(std::move(item)))
+            {
+                switch (_policy)
+                {
+                case overflow::drop_newest:
+                    _dropped.fetch_add(1);
+                    _pending.fetch_sub(1);
+                    return false;
+
+                case overflow::drop_oldest:
+                    {
+                        task oldest;
+                        if (_queue.try_pop(oldest))
+                        {
+                            _dropped.fetch_add(1);
+                            _pending.fetch_sub(1);
+                        }
+                    }
+                    break;
+
+                default:
+                    std::this_thread::yield();
+                }
+            }
+
+            /*
+             * try_push() claimed its cell with a seq_cst CAS, as work()
+             * increments _sleepers before checking for work. So either
+             * we see a worker going to sleep or it sees our task
+             */
+            if (_sleepers.load() != 0)
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                _wakeup.notify_one();
+            }
+
+            return true;
+        }
+
+        /**
+         * Queue a callable to be run by one of the workers
+         *
+         * @param[in] func The callable to run
+         *
+         * @return True if \a func was queued, or false if it was dropped
+         */
+        template <class F>
+        bool post(F&& func)
+        {
+            return post(task(std::forward<F>(func)));
+        }
+
+        /**
+         * @return The number of worker threads
+         */
+        std::size_t threads() const
+        {
+            return _workers.size();
+        }
+
+    private:
+
+        void work()
+        {
+            const int spins = 64;
+            task item;
+
+            for (;;)
+            {
+                for (int i = 0; i < spins; i++)
+                {
+                    if (_queue.try_pop(item))
+                    {
+                        run(item); i = 0;
+                    }
+                }
+
+                /*
+                 * Sleep. Announce ourselves before the final check of the
+                 * queue so that post() either sees us or we see its task
+                 */
+                std::unique_lock<std::mutex> lock(_lock);
+                _sleepers.fetch_add(1);
+
+                _wakeup.wait(lock, [this]() {
+                    return _stop.load() || !_queue.empty();
+                });
+
+                _sleepers.fetch_sub(1);
+
+                if (_stop.load() && _queue.empty())
+                    return;
+            }
+        }
+
+        void run(task& item)
+        {
+            item(); item = task();
+            _pending.fetch_sub(1);
+        }
+
+        std::atomic<std::size_t>
+            _dropped;
+
+        std::mutex _lock;
+
+        std::atomic<std::size_t>
+            _pending;
+
+        overflow _policy;
+
+        bounded_queue<task>
+            _queue;
+
+        std::atomic<int> _sleepers;
+
+        std::atomic<bool> _stop;
+
+        std::condition_variable
+            _wakeup;
+
+        std::vector<std::thread>
+            _workers;
+    };
+
+    /**
+     ******************************************************************
+     *
+     * @class Queued
+     *
+     * A \ref Signal whose handler runs asynchronously on a \ref
+     * Dispatcher. raise() copies its arguments (as \ref Signal::bind()
+     * would) into a task and returns as soon as the task is queued
+     *
+     * @note The handler must be attached before the signal is raised,
+     *       and the Queued must outlive every task it queues (see
+     *       Dispatcher::drain())
+     *
+     * @tparam R  The signal handler's return type. Return values are
+     *            ignored
+     * @tparam A  Specifies the type(s) of input arguments required by
+     *            the handler
+     *
+     ******************************************************************
+     */
+    template <class R, class... A>
+    class Queued
+    {
+        using args_type = std::tuple<typename std::remove_const<
+            typename std::remove_reference<A>::type>::type...>;
+
+        /*
+         * A single queued raise()
+         */
+        struct invocation
+        {
+            Queued<R,A...>* sig;
+            args_type       args;
+
+            void operator()()
+            {
+                run(typename gens<sizeof...(A)>::type());
+            }
+
+            /*
+             * Each invocation runs exactly once, so its arguments are
+             * moved into the handler rather than copied
+             */
+            template<int... S>
+            void run(seq<S...>)
+            {
+                sig->_sig.raise(consumed_arg<A>(std::get<S>(args))...);
+            }
+        };
+
+    public:
+
+        /**
+         * Constructor
+         *
+         * @param[in] dispatcher The Dispatcher on which to run the
+         *                       handler
+         */
+        explicit Queued(Dispatcher& dispatcher)
+            : _dispatcher(dispatcher), _sig()
+        {
+        }
+
+        Queued(const Queued<R,A...>& other) = delete;
+        Queued<R,A...>& operator=(const Queued<R,A...>& rhs) = delete;
+
+        /**
+         * Attach a handler, removing the previous handler (if it
+         * exists)
+         *
+         * @param[in] func A pointer to the signal handler
+         *
+         * @return True if the handler was successfully attached
+         */
+        bool attach(R(*func)(A...))
+        {
+            return _sig.attach(func);
+        }
+
+        /**
+         * Attach a handler, removing the previous handler (if it
+         * exists)
+         *
+         * @tparam C Class that implements the handler
+         *
+         * @param[in] obj  Object (of class C) through which to
+         *                 invoke the handler
+         * @param[in] func A pointer to the signal handler
+         *
+         * @return True if the handler was successfully attached
+         */
+        template <typename C>
+        bool attach(C& obj, R(C::*func)(A...))
+        {
+            return _sig.attach(obj, func);
+        }
+
+        /**
+         * Attach a handler, removing the previous handler (if it
+         * exists)
+         *
+         * @tparam C Class that implements the handler
+         *
+         * @param[in] obj  Object (of class C) through which to
+         *                 invoke the handler
+         * @param[in] func A pointer to the *const* handler
+         *
+         * @return True if the handler was successfully attached
+         */
+        template <typename C>
+        bool attach(C& obj, R(C::*func)(A...) const)
+        {
+            return _sig.attach(obj, func);
+        }
+
+        /**
+         * Detach the signal handler
+         *
+         * @return True on success, or false if no handler is attached
+         */
+        bool detach()
+        {
+            return _sig.detach();
+        }
+
+        /**
+         * @return The Dispatcher on which the handler runs
+         */
+        Dispatcher& dispatcher() const
+        {
+            return _dispatcher;
+        }
+
+        /**
+         * Check whether a handler is attached to this signal
+         *
+         * @return True if a handler is currently attached
+         */
+        bool is_connected() const
+        {
+            return _sig.is_connected();
+        }
+
+        /**
+         * Queue an invocation of the handler with copies of \a args
+         *
+         * @param[in] args The input arguments to provide the handler
+         *                 with
+         *
+         * @return True if the invocation was queued, or false if it
+         *         was dropped because the queue was full
+         */
+        bool raise(A... args)
+        {
+            invocation call = { this, args_type(std::forward<A>(args)...) };
+            return _dispatcher.post(std::move(call));
+        }
+
+    private:
+
+        Dispatcher& _dispatcher;
+
+        Signal<R,A...> _sig;
+    };
+}
+
+#endif // __QUEUED_H__
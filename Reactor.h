@@ -0,0 +1,832 @@
+/**
+ *  \file   Reactor.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __REACTOR_H__
+#define __REACTOR_H__
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#ifdef SIGNAL_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include "Signal.h"
+
+namespace Signal
+{
+    /**
+     * What a \ref Reactor waits on
+     */
+    enum class reactor_backend
+    {
+        epoll,    /**< epoll_wait() */
+        io_uring  /**< Polls submitted to an io_uring. Only available
+                       when compiled with SIGNAL_IO_URING */
+    };
+
+#if defined(SIGNAL_IO_URING) && !defined(DOXYGEN_SKIP)
+    /*
+     * Just enough of an io_uring to submit polls and reap their
+     * completions, driven with raw system calls so that liburing is not
+     * needed
+     */
+    class uring
+    {
+
+    public:
+
+        uring()
+            : _cq_head(nullptr), _cq_mask(nullptr), _cq_tail(nullptr),
+              _cqes(nullptr), _fd(-1), _ring(nullptr), _ring_len(0),
+              _sq_array(nullptr), _sq_entries(0), _sq_head(nullptr),
+              _sq_mask(nullptr), _sq_tail(nullptr), _sqes(nullptr),
+              _sqes_len(0)
+        {
+        }
+
+        uring(const uring& other)            = delete;
+        uring& operator=(const uring& rhs)   = delete;
+
+        ~uring()
+        {
+            close();
+        }
+
+        void close()
+        {
+            if (_sqes)
+                ::munmap(_sqes, _sqes_len);
+            if (_ring)
+                ::munmap(_ring, _ring_len);
+            if (_fd != -1)
+                ::close(_fd);
+
+            _fd = -1; _ring = nullptr; _sqes = nullptr;
+        }
+
+        /*
+         * Call f(user_data, res) for every completion waiting in
+         * the queue, then hand all of their entries back to the kernel
+         * at once
+         */
+        template <class F>
+        void harvest(F&& f)
+        {
+            unsigned head = *_cq_head;
+            const unsigned tail = __atomic_load_n(_cq_tail,
+                                                  __ATOMIC_ACQUIRE);
+
+            for (; head != tail; head++)
+            {
+                const io_uring_cqe& cqe = _cqes[head & *_cq_mask];
+                f(cqe.user_data, cqe.res);
+            }
+
+            __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+        }
+
+        /*
+         * Set up a ring with room for \a entries submissions. Fails on
+         * kernels older than 5.11, or where io_uring is disabled
+         */
+        bool open(unsigned entries)
+        {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+
+            _fd = static_cast<int>(
+                ::syscall(__NR_io_uring_setup, entries, &params));
+            if (_fd < 0)
+                return false;
+
+            const unsigned needed =
+                IORING_FEAT_SINGLE_MMAP | IORING_FEAT_EXT_ARG;
+
+            if ((params.features & needed) != needed)
+            {
+                close();
+                return false;
+            }
+
+            const std::size_t sq_len =
+                params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            const std::size_t cq_len =
+                params.cq_off.cqes +
+                    params.cq_entries * sizeof(io_uring_cqe);
+
+            _ring_len = sq_len > cq_len ? sq_len : cq_len;
+            _sqes_len = params.sq_entries * sizeof(io_uring_sqe);
+
+            void* ring = ::mmap(nullptr, _ring_len,
+                PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd,
+                IORING_OFF_SQ_RING);
+            if (ring == MAP_FAILED)
+            {
+                close();
+                return false;
+            }
+
+            _ring = ring;
+
+            void* sqes = ::mmap(nullptr, _sqes_len,
+                PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd,
+                IORING_OFF_SQES);
+            if (sqes == MAP_FAILED)
+            {
+                close();
+                return false;
+            }
+
+            _sqes = static_cast<io_uring_sqe*>(sqes);
+
+            unsigned char* base = static_cast<unsigned char*>(_ring);
+
+            _sq_head  = reinterpret_cast<unsigned*>(
+                base + params.sq_off.head);
+            _sq_tail  = reinterpret_cast<unsigned*>(
+                base + params.sq_off.tail);
+            _sq_mask  = reinterpret_cast<unsigned*>(
+                base + params.sq_off.ring_mask);
+            _sq_array = reinterpret_cast<unsigned*>(
+                base + params.sq_off.array);
+            _cq_head  = reinterpret_cast<unsigned*>(
+                base + params.cq_off.head);
+            _cq_tail  = reinterpret_cast<unsigned*>(
+                base + params.cq_off.tail);
+            _cq_mask  = reinterpret_cast<unsigned*>(
+                base + params.cq_off.ring_mask);
+            _cqes     = reinterpret_cast<io_uring_cqe*>(
+                base + params.cq_off.cqes);
+
+            _sq_entries = params.sq_entries;
+            return true;
+        }
+
+        /*
+         * Queue a poll of \a fd, which completes with \a data once \a fd
+         * is ready (or immediately, if it already is)
+         */
+        bool poll_add(int fd, std::uint32_t events, std::uint64_t data)
+        {
+            io_uring_sqe* sqe = next_sqe();
+            if (!sqe)
+                return false;
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            events = (events << 16) | (events >> 16);
+#endif
+            sqe->opcode        = IORING_OP_POLL_ADD;
+            sqe->fd            = fd;
+            sqe->poll32_events = events;
+            sqe->user_data     = data;
+
+            publish();
+            return true;
+        }
+
+        /*
+         * Queue the cancellation of the poll added with \a data. Its
+         * final completion is posted with \a tag
+         */
+        bool poll_remove(std::uint64_t data, std::uint64_t tag)
+        {
+            io_uring_sqe* sqe = next_sqe();
+            if (!sqe)
+                return false;
+
+            sqe->opcode    = IORING_OP_POLL_REMOVE;
+            sqe->fd        = -1;
+            sqe->addr      = data;
+            sqe->user_data = tag;
+
+            publish();
+            return true;
+        }
+
+        /*
+         * Submit whatever is queued, and wait up to \a timeout_ms
+         * milliseconds (forever if negative) for a completion
+         *
+         * Returns false on error, with errno set
+         */
+        bool wait(int timeout_ms)
+        {
+            __kernel_timespec ts;
+            io_uring_getevents_arg arg;
+
+            std::memset(&arg, 0, sizeof(arg));
+
+            if (timeout_ms >= 0)
+            {
+                ts.tv_sec  = timeout_ms / 1000;
+                ts.tv_nsec = (timeout_ms % 1000) * 1000000LL;
+                arg.ts = reinterpret_cast<std::uint64_t>(&ts);
+            }
+
+            const unsigned flags =
+                IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+
+            const long ret = ::syscall(__NR_io_uring_enter, _fd,
+                queued(), timeout_ms == 0 ? 0 : 1, flags, &arg,
+                sizeof(arg));
+
+            return ret >= 0 || errno == ETIME || errno == EINTR;
+        }
+
+    private:
+
+        io_uring_sqe* next_sqe()
+        {
+            if (queued() == _sq_entries && !enter())
+                return nullptr;
+
+            const unsigned index = *_sq_tail & *_sq_mask;
+
+            io_uring_sqe* sqe = &_sqes[index];
+            std::memset(sqe, 0, sizeof(*sqe));
+
+            _sq_array[index] = index;
+            return sqe;
+        }
+
+        unsigned queued() const
+        {
+            return *_sq_tail - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE);
+        }
+
+        bool enter()
+        {
+            return ::syscall(__NR_io_uring_enter, _fd, queued(), 0, 0,
+                             nullptr, 0) >= 0;
+        }
+
+        /*
+         * Publish the entry returned by next_sqe(). It is submitted with
+         * the next call to wait()
+         */
+        void publish()
+        {
+            __atomic_store_n(_sq_tail, *_sq_tail + 1, __ATOMIC_RELEASE);
+        }
+
+        unsigned* _cq_head;
+        unsigned* _cq_mask;
+        unsigned* _cq_tail;
+
+        io_uring_cqe* _cqes;
+
+        int _fd;
+
+        void* _ring;
+        std::size_t _ring_len;
+
+        unsigned* _sq_array;
+        unsigned  _sq_entries;
+        unsigned* _sq_head;
+        unsigned* _sq_mask;
+        unsigned* _sq_tail;
+
+        io_uring_sqe* _sqes;
+        std::size_t _sqes_len;
+    };
+#endif
+
+    /**
+     ******************************************************************
+     *
+     * @class Reactor
+     *
+     * An event loop that raises a signal whenever the file descriptor
+     * it was registered with becomes ready. Each handler is a
+     * Signal<void,int>, and receives the ready file descriptor. For
+     * example:
+     *
+     * @code
+     * Signal::Reactor reactor;
+     *
+     * reactor.add(sock, [&](int fd) { on_readable(fd); });
+     * reactor.add(pipe_fd, Signal::Signal<void,int>(obj, &C::drain));
+     *
+     * reactor.run();
+     * @endcode
+     *
+     * Readiness is level-triggered, so a handler need not read all that
+     * is available. Events are harvested in batches: each poll() hands
+     * up to the batch size of them to their handlers before waiting
+     * again
+     *
+     * Handlers may add and remove file descriptors, including their
+     * own. A removed handler is not raised again, even if it was ready
+     * in the same batch, and is destroyed once the batch is done
+     *
+     * With reactor_backend::io_uring, each file descriptor is watched
+     * by a poll on the ring that is re-armed after every event. The
+     * re-arms are submitted together with the next wait, so a whole
+     * batch of events takes one system call, where epoll would need
+     * one per handler that changes its registration. This needs
+     * SIGNAL_IO_URING defined before including this file, and Linux
+     * 5.11 or later. If the ring cannot be set up, the Reactor uses
+     * epoll instead; see backend()
+     *
+     * @note A Reactor is not thread-safe, except that stop() may be
+     *       called from any thread
+     *
+     ******************************************************************
+     */
+    class Reactor
+    {
+        using handler_type = Signal<void,int>;
+
+        /*
+         * A registered file descriptor. Events carry the index of their
+         * slot and its generation, which is bumped on removal so that
+         * events still in flight for a removed handler are ignored
+         */
+        struct slot
+        {
+            slot() : sig(), events(0), fd(-1), generation(0)
+            {
+            }
+
+            handler_type sig;
+
+            std::uint32_t events;
+
+            int fd;
+
+            std::uint32_t generation;
+        };
+
+        /*
+         * Identifies the wakeup eventfd, and (with io_uring) the
+         * completions of poll removals
+         */
+        static const std::uint64_t wake_tag   = ~std::uint64_t(0);
+        static const std::uint64_t remove_tag = ~std::uint64_t(0) - 1;
+
+        /*
+         * Frees the slots of handlers removed by other handlers once a
+         * batch is done, even if a handler throws
+         */
+        class dispatch_guard
+        {
+
+        public:
+
+            explicit dispatch_guard(Reactor& reactor) : _reactor(reactor)
+            {
+                _reactor._dispatching = true;
+            }
+
+            ~dispatch_guard()
+            {
+                _reactor._dispatching = false;
+
+                for (std::size_t i = 0; i < _reactor._retired.size(); i++)
+                    _reactor.release(_reactor._retired[i]);
+
+                _reactor._retired.clear();
+            }
+
+        private:
+
+            Reactor& _reactor;
+        };
+
+    public:
+
+        /**
+         * Constructor
+         *
+         * @param[in] backend What to wait on. io_uring falls back to
+         *                    epoll if unavailable
+         * @param[in] batch   The most events to handle per poll()
+         */
+        explicit Reactor(reactor_backend backend = reactor_backend::epoll,
+                         std::size_t batch = 64)
+            : _backend(reactor_backend::epoll), _dispatching(false),
+              _epoll(-1), _events(batch ? batch : 1), _free(), _index(),
+              _retired(), _size(0), _slots(), _stop(false), _wake(-1)
+        {
+            _wake = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (_wake == -1)
+                return;
+
+#ifdef SIGNAL_IO_URING
+            if (backend == reactor_backend::io_uring &&
+                _ring.open(static_cast<unsigned>(_events.size())))
+            {
+                _backend = reactor_backend::io_uring;
+                _ring.poll_add(_wake, EPOLLIN, wake_tag);
+                return;
+            }
+#else
+            (void)backend;
+#endif
+            _epoll = ::epoll_create1(EPOLL_CLOEXEC);
+            if (_epoll == -1)
+                return;
+
+            epoll_event event;
+            event.events   = EPOLLIN;
+            event.data.u64 = wake_tag;
+
+            if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, _wake, &event) != 0)
+            {
+                ::close(_epoll);
+                _epoll = -1;
+            }
+        }
+
+        Reactor(const Reactor& other)            = delete;
+        Reactor& operator=(const Reactor& rhs)   = delete;
+
+        /**
+         * Destructor
+         */
+        ~Reactor()
+        {
+#ifdef SIGNAL_IO_URING
+            _ring.close();
+#endif
+            if (_epoll != -1)
+                ::close(_epoll);
+            if (_wake != -1)
+                ::close(_wake);
+        }
+
+        /**
+         * Start raising a handler whenever a file descriptor is ready
+         *
+         * @param[in] fd      The file descriptor. The Reactor does not
+         *                    take ownership of it, but it should be
+         *                    removed before it is closed
+         * @param[in] sig     The handler, e.g. a function pointer or a
+         *                    lambda, which receives \a fd
+         * @param[in] events  What to wait for, e.g. EPOLLIN or EPOLLOUT
+         *
+         * @return True on success, or false if \a fd is invalid or
+         *         already registered, or \a sig has no handler
+         */
+        bool add(int fd, handler_type sig, std::uint32_t events = EPOLLIN)
+        {
+            if (fd < 0 || !is_open() || is_registered(fd) ||
+                !sig.is_connected())
+            {
+                return false;
+            }
+
+            std::uint32_t index;
+            if (_free.empty())
+            {
+                index = static_cast<std::uint32_t>(_slots.size());
+                _slots.emplace_back();
+            }
+            else
+            {
+                index = _free.back();
+                _free.pop_back();
+            }
+
+            slot& s = _slots[index];
+            s.sig    = std::move(sig);
+            s.events = events;
+            s.fd     = fd;
+
+            if (!arm(s, index))
+            {
+                s.sig.detach();
+                s.fd = -1;
+                _free.push_back(index);
+                return false;
+            }
+
+            if (_index.size() <= static_cast<std::size_t>(fd))
+                _index.resize(fd + 1, 0);
+
+            _index[fd] = index + 1;
+            _size++;
+
+            return true;
+        }
+
+        /**
+         * @return What this Reactor waits on
+         */
+        reactor_backend backend() const
+        {
+            return _backend;
+        }
+
+        /**
+         * @return True if the Reactor was set up successfully
+         */
+        bool is_open() const
+        {
+            return _epoll != -1 || _backend == reactor_backend::io_uring;
+        }
+
+        /**
+         * Check whether a file descriptor has a handler
+         *
+         * @param[in] fd The file descriptor
+         *
+         * @return True if \a fd is registered
+         */
+        bool is_registered(int fd) const
+        {
+            return fd >= 0 && static_cast<std::size_t>(fd) < _index.size()
+                && _index[fd] != 0;
+        }
+
+        /**
+         * Wait for file descriptors to become ready, and raise their
+         * handlers
+         *
+         * @param[in] timeout_ms The most milliseconds to wait, or -1 to
+         *                       wait indefinitely. With 0, only handlers
+         *                       of file descriptors that are already
+         *                       ready are raised
+         *
+         * @return The number of handlers raised, or -1 on error, with
+         *         errno set
+         */
+        int poll(int timeout_ms = -1)
+        {
+            dispatch_guard guard(*this);
+
+#ifdef SIGNAL_IO_URING
+            if (_backend == reactor_backend::io_uring)
+                return poll_ring(timeout_ms);
+#endif
+            return poll_epoll(timeout_ms);
+        }
+
+        /**
+         * Stop raising a file descriptor's handler
+         *
+         * @param[in] fd The file descriptor
+         *
+         * @return True on success, or false if \a fd was not registered
+         */
+        bool remove(int fd)
+        {
+            if (!is_registered(fd))
+                return false;
+
+            const std::uint32_t index = _index[fd] - 1;
+            slot& s = _slots[index];
+
+            disarm(s, index);
+
+            s.fd = -1;
+            s.generation++;
+
+            _index[fd] = 0;
+            _size--;
+
+            if (_dispatching)
+                _retired.push_back(index);
+            else
+                release(index);
+
+            return true;
+        }
+
+        /**
+         * Call poll() until stop() is called
+         *
+         * @return False if poll() failed, or true once stopped
+         */
+        bool run()
+        {
+            while (!_stop.load(std::memory_order_acquire))
+            {
+                if (poll(-1) < 0)
+                    return false;
+            }
+
+            _stop.store(false, std::memory_order_relaxed);
+            return true;
+        }
+
+        /**
+         * @return The number of registered file descriptors
+         */
+        std::size_t size() const
+        {
+            return _size;
+        }
+
+        /**
+         * Make run() return once the handlers of the current batch are
+         * done. This may be called from any thread, or from a handler
+         */
+        void stop()
+        {
+            _stop.store(true, std::memory_order_release);
+
+            const std::uint64_t one = 1;
+            if (::write(_wake, &one, sizeof(one)) < 0)
+            {
+                // The counter is full, so a wakeup is already pending
+            }
+        }
+
+    private:
+
+        bool arm(const slot& s, std::uint32_t index)
+        {
+#ifdef SIGNAL_IO_URING
+            if (_backend == reactor_backend::io_uring)
+                return _ring.poll_add(s.fd, s.events, tag(s, index));
+#endif
+            epoll_event event;
+            event.events   = s.events;
+            event.data.u64 = tag(s, index);
+
+            return ::epoll_ctl(_epoll, EPOLL_CTL_ADD, s.fd, &event) == 0;
+        }
+
+        /*
+         * The file descriptor may already be closed, which removes it
+         * from an epoll set, so errors are ignored
+         */
+        void disarm(const slot& s, std::uint32_t index)
+        {
+#ifdef SIGNAL_IO_URING
+            if (_backend == reactor_backend::io_uring)
+            {
+                _ring.poll_remove(tag(s, index), remove_tag);
+                return;
+            }
+#else
+            (void)index;
+#endif
+            epoll_event event;
+            std::memset(&event, 0, sizeof(event));
+
+            ::epoll_ctl(_epoll, EPOLL_CTL_DEL, s.fd, &event);
+        }
+
+        /*
+         * Raise the handler an event is for, unless it has since been
+         * removed. Returns the number of handlers raised
+         */
+        int dispatch(std::uint64_t data)
+        {
+            if (data == wake_tag)
+            {
+                std::uint64_t count;
+                if (::read(_wake, &count, sizeof(count)) < 0)
+                {
+                    // Another batch already drained it
+                }
+
+                return 0;
+            }
+
+            const std::uint32_t index = static_cast<std::uint32_t>(data);
+
+            if (index >= _slots.size())
+                return 0;
+
+            slot& s = _slots[index];
+
+            if (s.fd < 0 || s.generation != (data >> 32))
+                return 0;
+
+            s.sig.raise(s.fd);
+            return 1;
+        }
+
+        int poll_epoll(int timeout_ms)
+        {
+            const int n = ::epoll_wait(_epoll, _events.data(),
+                static_cast<int>(_events.size()), timeout_ms);
+
+            if (n < 0)
+                return errno == EINTR ? 0 : -1;
+
+            int raised = 0;
+            for (int i = 0; i < n; i++)
+                raised += dispatch(_events[i].data.u64);
+
+            return raised;
+        }
+
+#ifdef SIGNAL_IO_URING
+        int poll_ring(int timeout_ms)
+        {
+            if (!_ring.wait(timeout_ms))
+                return -1;
+
+            int raised = 0;
+
+            _ring.harvest([this, &raised](std::uint64_t data, int res) {
+                if (data == remove_tag)
+                    return;
+
+                if (res >= 0)
+                    raised += dispatch(data);
+
+                if (res != -EBADF)
+                    rearm(data);
+            });
+
+            return raised;
+        }
+
+        /*
+         * Polls are one-shot, which keeps readiness level-triggered as
+         * with epoll, so those that are still wanted are resubmitted.
+         * This includes polls that completed with an error, e.g. because
+         * they were interrupted or cancelled, unless the file descriptor
+         * has been closed, since epoll would go on watching all others
+         */
+        void rearm(std::uint64_t data)
+        {
+            if (data == wake_tag)
+            {
+                _ring.poll_add(_wake, EPOLLIN, wake_tag);
+                return;
+            }
+
+            const std::uint32_t index = static_cast<std::uint32_t>(data);
+            const slot& s = _slots[index];
+
+            if (s.fd >= 0 && s.generation == (data >> 32))
+                _ring.poll_add(s.fd, s.events, data);
+        }
+#endif
+
+        void release(std::uint32_t index)
+        {
+            _slots[index].sig.detach();
+            _free.push_back(index);
+        }
+
+        static std::uint64_t tag(const slot& s, std::uint32_t index)
+        {
+            return (std::uint64_t(s.generation) << 32) | index;
+        }
+
+        reactor_backend _backend;
+
+        bool _dispatching;
+
+        int _epoll;
+
+        std::vector<epoll_event>
+            _events;
+
+        std::vector<std::uint32_t>
+            _free;
+
+        /*
+         * Maps each file descriptor to one more than the index of its
+         * slot, or to zero if it is not registered
+         */
+        std::vector<std::uint32_t>
+            _index;
+
+        std::vector<std::uint32_t>
+            _retired;
+
+#ifdef SIGNAL_IO_URING
+        uring _ring;
+#endif
+
+        std::size_t _size;
+
+        /*
+         * A deque, so that adding a handler never moves one that is
+         * being raised
+         */
+        std::deque<slot>
+            _slots;
+
+        std::atomic<bool> _stop;
+
+        int _wake;
+    };
+}
+
+#endif // __REACTOR_H__
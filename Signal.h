@@ -11,9 +11,31 @@
 
 #include <cstddef>
 #include <memory>
+#include <new>
+#include <stdexcept>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
+#ifdef SIGNAL_INSTRUMENT
+#include "Instrument.h"
+#endif
+
+/*
+ * The number of bytes each Signal sets aside for a callable handler's
+ * captures. Callables that fit are stored inside the Signal, and larger
+ * ones on the heap. This must be the same in every translation unit
+ *
+ * Likewise, SIGNAL_INSTRUMENT (see Instrument.h) adds a member to each
+ * Signal, so it must be either defined or not in every translation unit
+ * of a program. Mixing the two changes the size and layout of Signal
+ * from one to the next, which is an ODR violation that no compiler or
+ * linker will report
+ */
+#ifndef SIGNAL_CALLABLE_CAPACITY
+#define SIGNAL_CALLABLE_CAPACITY (4 * sizeof(void*))
+#endif
+
 namespace Signal
 {
 
@@ -42,20 +64,473 @@ namespace Signal
     };
 
     /*
-     * A container for bound/forwarded function arguments:
+     * Bound/forwarded function arguments, and whether they are to be
+     * moved into the handler or forwarded by reference. The pointers
+     * come first so that small arguments fit in the padding after them
      */
     template <class... T>
-    struct SignalArgs
+    struct args_state
     {
-        std::tuple<typename std::remove_const<
+        typedef std::tuple<typename std::remove_const<
                    typename std::remove_reference<T>::type>::type...>
-            args;
+            args_type;
+
+        typedef std::tuple<typename std::add_pointer<T>::type...>
+            ptrs_type;
+
+        args_state() : ptrs(), args(), consume(false), forward(false)
+        {
+        }
+
+        ptrs_type ptrs;
+        args_type args;
+
+        bool consume;
+        bool forward;
+    };
+
+    /*
+     * Whether no T is a reference to non-const, i.e. whether a handler
+     * can never write through the arguments it is given
+     */
+    template <class... T>
+    struct args_readonly : std::true_type
+    {
+    };
+
+    template <class T1, class... T>
+    struct args_readonly<T1, T...>
+        : std::integral_constant<bool,
+              (!std::is_reference<T1>::value ||
+               std::is_const<typename std::remove_reference<T1>::type>::value)
+              && args_readonly<T...>::value>
+    {
+    };
+
+    /*
+     * The number of bytes each SignalArgs sets aside to hold its state
+     * inline, which is enough for a single scalar argument
+     */
+    constexpr std::size_t args_capacity = 2 * sizeof(void*);
+
+    /*
+     * Where a SignalArgs keeps its state S: inline if it fits in
+     * args_capacity bytes and moves without throwing, or on the heap
+     * otherwise. Either way the holder takes args_capacity bytes, so a
+     * signal's size does not depend on its arguments
+     */
+    template <class S, bool Inline =
+        sizeof(S) <= args_capacity && alignof(S) <= alignof(void*) &&
+        std::is_nothrow_move_constructible<S>::value &&
+        std::is_nothrow_move_assignable<S>::value>
+    class args_holder
+    {
+
+    public:
+
+        args_holder()
+        {
+            ::new (static_cast<void*>(&_buf)) S();
+        }
+
+        args_holder(const args_holder& other)
+        {
+            ::new (static_cast<void*>(&_buf)) S(*other.find());
+        }
+
+        args_holder(args_holder&& other) noexcept
+        {
+            ::new (static_cast<void*>(&_buf)) S(std::move(*other.find()));
+        }
+
+        ~args_holder()
+        {
+            find()->~S();
+        }
+
+        args_holder& operator=(const args_holder& rhs)
+        {
+            *find() = *rhs.find();
+            return *this;
+        }
+
+        args_holder& operator=(args_holder&& rhs) noexcept
+        {
+            *find() = std::move(*rhs.find());
+            return *this;
+        }
+
+        S* find()
+        {
+            return reinterpret_cast<S*>(&_buf);
+        }
+
+        const S* find() const
+        {
+            return reinterpret_cast<const S*>(&_buf);
+        }
+
+        S& get()
+        {
+            return *find();
+        }
+
+    private:
+
+        typename std::aligned_storage<args_capacity,
+                                      alignof(void*)>::type _buf;
+    };
+
+    template <class S>
+    class args_holder<S, false>
+    {
+
+    public:
+
+        args_holder() : _state(nullptr)
+        {
+        }
+
+        args_holder(const args_holder& other)
+            : _state(other._state ? new S(*other._state) : nullptr)
+        {
+        }
+
+        args_holder(args_holder&& other) noexcept
+            : _state(other._state)
+        {
+            other._state = nullptr;
+        }
+
+        ~args_holder()
+        {
+            delete _state;
+        }
+
+        args_holder& operator=(const args_holder& rhs)
+        {
+            if (this == &rhs)
+                return *this;
+
+            if (rhs._state == nullptr)
+            {
+                delete _state; _state = nullptr;
+            }
+            else if (_state)
+                *_state = *rhs._state;
+            else
+                _state = new S(*rhs._state);
+
+            return *this;
+        }
+
+        args_holder& operator=(args_holder&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                delete _state;
+                _state = rhs._state; rhs._state = nullptr;
+            }
+
+            return *this;
+        }
+
+        S* find()
+        {
+            return _state;
+        }
+
+        const S* find() const
+        {
+            return _state;
+        }
+
+        S& get()
+        {
+            if (_state == nullptr)
+                _state = new S();
+
+            return *_state;
+        }
+
+    private:
+
+        union
+        {
+            S* _state;
+            typename std::aligned_storage<args_capacity,
+                                          alignof(void*)>::type _pad;
+        };
+    };
+
+    /*
+     * A container for bound/forwarded function arguments. Small
+     * arguments are kept inline. Larger ones live on the heap, and are
+     * only allocated the first time they are bound or forwarded, since
+     * most signals never bind or forward anything
+     */
+    template <class... T>
+    class SignalArgs
+    {
+        typedef args_state<T...> state;
+
+    public:
+
+        typedef typename state::args_type args_type;
+        typedef typename state::ptrs_type ptrs_type;
+
+        args_type& args()
+        {
+            if (!args_readonly<T...>::value)
+                return _holder.get().args;
+
+            state* s = _holder.find();
+            return s ? s->args : unbound();
+        }
+
+        ptrs_type& ptrs()
+        {
+            return _holder.get().ptrs;
+        }
+
+        template <class... U>
+        void bind(U&&... args)
+        {
+            if (sizeof...(T) == 0)
+                return;
+
+            state& s = _holder.get();
+            s.args = std::forward_as_tuple(std::forward<U>(args)...);
+            s.consume = false; s.forward = false;
+        }
+
+        template <class... U>
+        void bind_once(U&&... args)
+        {
+            bind(std::forward<U>(args)...);
+
+            if (state* s = _holder.find())
+                s->consume = true;
+        }
+
+        void forward(typename std::remove_reference<T>::type&... args)
+        {
+            if (sizeof...(T) == 0)
+                return;
+
+            state& s = _holder.get();
+            s.ptrs = std::make_tuple(&args...);
+            s.consume = false; s.forward = true;
+        }
+
+        bool has_refs() const
+        {
+            const state* s = _holder.find();
+            return s && s->forward;
+        }
+
+        bool is_bound_once() const
+        {
+            const state* s = _holder.find();
+            return s && s->consume;
+        }
+
+    private:
+
+        /*
+         * What a signal raised without bound arguments is given, so
+         * that raising it never allocates. It is shared by every signal
+         * of this type in every thread, so it is only handed out when
+         * handlers cannot modify it; otherwise each signal gets its own
+         */
+        static args_type& unbound()
+        {
+            static args_type none;
+            return none;
+        }
+
+        args_holder<state> _holder;
+    };
+
+    /*
+     * Pass a stored (bound or forwarded) argument on to a handler that
+     * takes an A. Reference arguments are passed through as-is, while
+     * by-value arguments are copied, since the stored value must be left
+     * intact for the next raise()
+     */
+    template <class A, class T>
+    inline typename std::conditional<std::is_reference<A>::value, A,
+        typename std::remove_const<A>::type>::type stored_arg(T& arg)
+    {
+        return arg;
+    }
+
+    /*
+     * Hand a bound argument over to a handler that takes an A, leaving
+     * the stored value moved-from. Only non-const lvalue references are
+     * passed as lvalues; everything else is passed as an rvalue
+     */
+    template <class A, class T>
+    struct consumed
+    {
+        typedef typename std::conditional<
+            std::is_lvalue_reference<A>::value &&
+            !std::is_const<typename std::remove_reference<A>::type>::value,
+            T&, T&&>::type type;
+    };
+
+    template <class A, class T>
+    inline typename consumed<A,T>::type consumed_arg(T& arg)
+    {
+        return static_cast<typename consumed<A,T>::type>(arg);
+    }
+
+    /*
+     * Identifies a class without RTTI: each class_id<C>::tag has its
+     * own address. The tag must not be const, since identical constants
+     * may be merged into one object (-fmerge-all-constants, identical
+     * code folding), which would give two classes the same address
+     */
+    template <class C>
+    struct class_id
+    {
+        static char tag;
+    };
+
+    template <class C>
+    char class_id<C>::tag = 0;
+
+    /*
+     * A batch of arguments in structure-of-arrays form, i.e. one array
+     * per handler argument. See columns()
+     */
+    template <class... T>
+    struct column_batch
+    {
+        std::tuple<T*...> cols;
+    };
+
+    /*
+     * Utilities for invoking a handler once per entry of a batch, where
+     * a batch is either a pointer to an array of argument tuples or a
+     * column_batch:
+     */
+    template <class Batch>
+    struct batch_traits;
+
+    template <class... T>
+    struct batch_traits<std::tuple<T...>*>
+    {
+        static const int size = sizeof...(T);
+    };
+
+    template <class... T>
+    struct batch_traits<const std::tuple<T...>*>
+    {
+        static const int size = sizeof...(T);
+    };
 
-        std::tuple<typename std::add_pointer<T>::type...>
-            ptrs;
+    template <class... T>
+    struct batch_traits<column_batch<T...>>
+    {
+        static const int size = sizeof...(T);
     };
+
+    template <class F, class... T, int... S>
+    inline auto batch_call(F& f, std::tuple<T...>* batch, std::size_t i,
+                           seq<S...>)
+        -> decltype(f(std::get<S>(batch[i])...))
+    {
+        return f(std::get<S>(batch[i])...);
+    }
+
+    template <class F, class... T, int... S>
+    inline auto batch_call(F& f, const std::tuple<T...>* batch,
+                           std::size_t i, seq<S...>)
+        -> decltype(f(std::get<S>(batch[i])...))
+    {
+        return f(std::get<S>(batch[i])...);
+    }
+
+    template <class F, class... T, int... S>
+    inline auto batch_call(F& f, const column_batch<T...>& batch,
+                           std::size_t i, seq<S...>)
+        -> decltype(f(std::get<S>(batch.cols)[i]...))
+    {
+        return f(std::get<S>(batch.cols)[i]...);
+    }
+
+    template <class F, class Batch>
+    inline void batch_run(F& f, const Batch& batch, std::size_t n)
+    {
+        typedef typename gens<batch_traits<Batch>::size>::type indices;
+
+        for (std::size_t i = 0; i < n; i++)
+            batch_call(f, batch, i, indices());
+    }
+
+    template <class F, class Batch, class T>
+    inline void batch_run(F& f, const Batch& batch, std::size_t n,
+                          T* results)
+    {
+        typedef typename gens<batch_traits<Batch>::size>::type indices;
+
+        for (std::size_t i = 0; i < n; i++)
+            results[i] = batch_call(f, batch, i, indices());
+    }
 #endif
 
+    /**
+     * Describe a batch of handler arguments as one array per argument,
+     * for use with raise_batch(). Entry i of the batch consists of the
+     * i-th element of each array
+     *
+     * @param[in] cols One array for each handler argument
+     *
+     * @return The batch
+     */
+    template <class... T>
+    column_batch<T...> columns(T*... cols)
+    {
+        column_batch<T...> batch = { std::make_tuple(cols...) };
+        return batch;
+    }
+
+    /**
+     ******************************************************************
+     *
+     * @class arena
+     *
+     * A source of memory for signals created by clone(arena&). See
+     * \ref pool for one that hands out fixed-size blocks
+     *
+     ******************************************************************
+     */
+    class arena
+    {
+
+    public:
+
+        virtual ~arena() {}
+
+        /**
+         * Allocate memory, throwing std::bad_alloc on failure
+         *
+         * @param[in] size  The number of bytes required
+         * @param[in] align The required alignment
+         *
+         * @return The memory
+         */
+        virtual void* allocate(std::size_t size, std::size_t align) = 0;
+
+        /**
+         * Return memory obtained from allocate()
+         *
+         * @param[in] ptr The memory to return
+         */
+        virtual void deallocate(void* ptr) = 0;
+    };
+
     /**
      ******************************************************************
      *
@@ -76,15 +551,53 @@ namespace Signal
         virtual generic* clone()    const = 0;
         virtual bool is_connected() const = 0;
         virtual void v_raise() = 0;
+
+        /**
+         * Create a copy of this object in memory drawn from \a mem.
+         * Release the copy with \ref dispose()
+         *
+         * @param[in] mem The arena from which to allocate the copy
+         *
+         * @return A \ref generic pointer to the newly created object
+         */
+        virtual generic* clone(arena& mem) const = 0;
     };
 
+    /**
+     * Destroy a signal created by generic::clone(arena&), returning its
+     * memory to the arena
+     *
+     * @param[in] sig The signal to destroy. May be null
+     * @param[in] mem The arena \a sig was allocated from
+     */
+    inline void dispose(generic* sig, arena& mem)
+    {
+        if (sig)
+        {
+            void* ptr = dynamic_cast<void*>(sig);
+            sig->~generic();
+            mem.deallocate(ptr);
+        }
+    }
+
+#ifndef DOXYGEN_SKIP
+    /*
+     * Copy-construct obj in memory drawn from mem
+     */
+    template <class T>
+    inline generic* clone_in(arena& mem, const T& obj)
+    {
+        return ::new (mem.allocate(sizeof(T), alignof(T))) T(obj);
+    }
+#endif
+
     /**
      ******************************************************************
      *
      * @class signal_t
      *
      * An interface that can be used to access your signal when it is
-     * either a \ref fcn_ptr or \ref mem_ptr
+     * a \ref fcn_ptr, \ref fcn_obj or \ref mem_ptr
      *
      * @tparam R  Signal handler return type
      * @tparam A  Specifies the type(s) of each input argument to the
@@ -98,18 +611,74 @@ namespace Signal
 
     public:
 
+        signal_t() = default;
+
+        /*
+         * Declared explicitly, since the virtual destructor would
+         * otherwise suppress the move operations and leave derived
+         * classes copying the bound arguments when moved
+         */
+        signal_t(const signal_t<R,A...>& other) = default;
+        signal_t(signal_t<R,A...>&& other)      = default;
+
+        signal_t<R,A...>& operator=(const signal_t<R,A...>& rhs) = default;
+        signal_t<R,A...>& operator=(signal_t<R,A...>&& rhs)      = default;
+
         virtual ~signal_t() {}
 
         virtual void bind(A...)        = 0;
+        virtual void bind_once(A...)   = 0;
         virtual generic* clone() const = 0;
+        virtual generic* clone(arena& mem) const = 0;
         virtual bool detach()          = 0;
         virtual void forward(
             typename std::remove_reference<A>::type&... args) = 0;
         virtual bool has_refs()  const = 0;
+        virtual bool is_bound_once() const = 0;
         virtual R raise(A...)          = 0;
 
         /**
-         * Arguments to forward to the handler
+         * A function that invokes the handler of the object passed to
+         * it, without virtual dispatch
+         */
+        using thunk_type = R(*)(void*, A&&...);
+
+        /**
+         * @return The thunk that invokes this object's handler
+         */
+        virtual thunk_type thunk() const = 0;
+
+        /**
+         * Copy-construct this object into caller-provided storage
+         *
+         * @param[in] buf Suitably sized and aligned raw storage
+         *
+         * @return A pointer to the new object, which must be released
+         *         by explicitly invoking its destructor
+         */
+        virtual signal_t* copy_to(void* buf) const = 0;
+
+        /**
+         * Move-construct this object into caller-provided storage
+         *
+         * @param[in] buf Suitably sized and aligned raw storage
+         *
+         * @return A pointer to the new object, which must be released
+         *         by explicitly invoking its destructor
+         */
+        virtual signal_t* move_to(void* buf)       = 0;
+
+        /**
+         * Move-construct this object onto the heap. Unlike clone(),
+         * this works for move-only handlers
+         *
+         * @return A pointer to the new object, which must be released
+         *         with delete
+         */
+        virtual signal_t* move_to_heap()           = 0;
+
+        /**
+         * Arguments to forward to the handler
          */
         SignalArgs< A... > 
             _sargs;
@@ -145,8 +714,7 @@ namespace Signal
          *                 handler
          */
         mem_ptr(C& obj)
-            : _const_func(nullptr), _forward(false), _func(nullptr),
-              _is_init(false), _obj(obj)
+            : _const(false), _func(nullptr), _obj(obj)
         {
         }
 
@@ -159,121 +727,906 @@ namespace Signal
          *                 class C
          */
         mem_ptr(C& obj, const Handler func)
-            : _const_func(nullptr), _forward(false), _func(func),
+            : _const(false), _func(func), _obj(obj)
+        {
+        }
+
+        /**
+         * Constructor (3)
+         *
+         * @param[in] obj  The object through which to invoke the signal
+         *                 handler
+         * @param[in] func A pointer to the *const* signal handler which
+         *                 is a member of class C
+         */
+        mem_ptr(C& obj, const const_Handler func)
+            : _const(true), _func(reinterpret_cast<Handler>(func)),
               _obj(obj)
         {
-            _is_init = _func != nullptr;
         }
 
+        mem_ptr(const mem_ptr<R,C,A...>& other) = default;
+        mem_ptr(mem_ptr<R,C,A...>&& other)      = default;
+
+        /**
+         * Destructor
+         */
+        virtual ~mem_ptr()
+        {
+        }
+
+        /**
+         * Attach a new signal handler
+         *
+         * @param[in] func A pointer to the handler which is a member of
+         *                 class C
+         *
+         * @return True on success
+         */
+        bool attach(const Handler func)
+        {
+            if (func == nullptr)
+                return false;
+
+            _const = false; _func = func;
+            return true;
+        }
+
+        /**
+         * Attach a new signal handler
+         *
+         * @param[in] func A pointer to the *const* signal handler which
+         *                 is a member of class C
+         *
+         * @return True on success
+         */
+        bool attach(const const_Handler func)
+        {
+            if (func == nullptr)
+                return false;
+
+            _const = true; _func = reinterpret_cast<Handler>(func);
+            return true;
+        }
+
+        /**
+         * Bind arguments to the signal handler. This avoids having
+         * to call raise() with explicit inputs
+         *
+         * @note This creates internal copies of \a args to pass to
+         *       the signal handler, moving any that are given as
+         *       rvalues. See \ref forward() if you wish to forward
+         *       references instead
+         *
+         * @param[in] args Input arguments to implicitly forward
+         *                 to the handler
+         */
+        void bind(A... args)
+        {
+            this->_sargs.bind(std::forward<A>(args)...);
+        }
+
+        /**
+         * Bind arguments to the signal handler, to be moved into it
+         * (rather than copied) by the next call to raise(). After that
+         * the bound arguments are left moved-from, so they should be
+         * bound again before raise() is next called without inputs
+         *
+         * @param[in] args Input arguments to implicitly forward
+         *                 to the handler
+         */
+        void bind_once(A... args)
+        {
+            this->_sargs.bind_once(std::forward<A>(args)...);
+        }
+
+        /**
+         * A factory method that creates a copy of this object
+         *
+         * @return A \ref generic pointer to the newly created
+         *         object
+         */
+        generic* clone() const
+        {
+            return new mem_ptr<R,C,A...>(*this);
+        }
+
+        /**
+         * A factory method that creates a copy of this object in memory
+         * drawn from \a mem
+         *
+         * @param[in] mem The arena from which to allocate the copy
+         *
+         * @return A \ref generic pointer to the newly created
+         *         object
+         */
+        generic* clone(arena& mem) const
+        {
+            return clone_in(mem, *this);
+        }
+
+        signal_t<R,A...>* copy_to(void* buf) const
+        {
+            return ::new (buf) mem_ptr<R,C,A...>(*this);
+        }
+
+        signal_t<R,A...>* move_to(void* buf)
+        {
+            return ::new (buf) mem_ptr<R,C,A...>(std::move(*this));
+        }
+
+        signal_t<R,A...>* move_to_heap()
+        {
+            return new mem_ptr<R,C,A...>(std::move(*this));
+        }
+
+        /**
+         * Detach the current signal handler
+         *
+         * @return True on success
+         */
+        bool detach()
+        {
+            _const = false; _func = nullptr;
+            return true;
+        }
+
+        /**
+         * Forward arguments to the signal handler. Unlike \ref bind(),
+         * which forwards copies, this will forward \a args by
+         * reference, e.g. in case they need to be modified within the
+         * signal handler
+         *
+         * @warning
+         * Forwarding references may lead to undefined behavior if you
+         * allow \a args to go out of scope
+         *
+         * @param[in] args Input arguments to implicitly forward
+         */
+        void forward(typename std::remove_reference<A>::type&... args)
+        {
+            this->_sargs.forward(args...);
+        }
+
+        /**
+         * @return True if reference forwarding is enabled
+         */
+        bool has_refs() const
+        {
+            return this->_sargs.has_refs();
+        }
+
+        /**
+         * @return True if the bound arguments will be moved into the
+         *         handler by the next raise(). See \ref bind_once()
+         */
+        bool is_bound_once() const
+        {
+            return this->_sargs.is_bound_once();
+        }
+
+        /**
+         * Determine if this signal is currently attached via \ref
+         * attach()
+         *
+         * @return True if attached
+         */
+        bool is_connected() const
+        {
+            return _func != nullptr;
+        }
+
+        /**
+         * Invoke the signal handler. This will fail if no handler is
+         * attached, which can be verified with is_connected()
+         *
+         * @param[in] args The input arguments to provide the handler
+         *                 with
+         *
+         * @return The return value of the handler
+         */
+        R raise(A... args)
+        {
+            if (!_const)
+                return (_obj.*_func)(std::forward<A>(args)...);
+            else
+                return
+                 (_obj.*const_func())(std::forward<A>(args)...);
+        }
+
+        /**
+         * Forward bound arguments to the signal handler. Note this
+         * will fail if no handler is currently attached, which can
+         * be verified with is_connected()
+         *
+         * @return The return value of the handler
+         */
+        template <int N=0>
+        R raise()
+        {
+            return
+                run(typename gens<sizeof...(A)>::type());
+        }
+
+        /**
+         * Forward bound arguments to the signal handler. Note this
+         * will fail if no handler is currently attached, which can
+         * be verified with is_connected()
+         *
+         * This is equivalent to \ref raise() except that it can be
+         * invoked through a \ref generic
+         */
+        void v_raise()
+        {
+            raise();
+        }
+
+        /**
+         * Invoke the handler once for each entry of a batch of inputs.
+         * The handler is looked up once rather than once per entry
+         *
+         * @param[in] batch Either a pointer to \a n std::tuples, each
+         *                  holding the arguments for one call, or the
+         *                  result of \ref columns()
+         * @param[in] n     The number of entries in \a batch
+         */
+        template <class Batch>
+        void raise_batch(Batch batch, std::size_t n)
+        {
+            run_batch(batch, n);
+        }
+
+        /**
+         * Invoke the handler once for each entry of a batch of inputs,
+         * storing the return values. The handler is looked up once
+         * rather than once per entry
+         *
+         * @param[in]  batch   Either a pointer to \a n std::tuples, each
+         *                     holding the arguments for one call, or the
+         *                     result of \ref columns()
+         * @param[in]  n       The number of entries in \a batch
+         * @param[out] results Receives the return value of each call.
+         *                     This must have room for \a n values
+         */
+        template <class Batch, class T>
+        void raise_batch(Batch batch, std::size_t n, T* results)
+        {
+            run_batch(batch, n, results);
+        }
+
+        /**
+         * @return The thunk that invokes this object's handler, which
+         *         depends on whether it is a *const* member function
+         */
+        typename signal_t<R,A...>::thunk_type thunk() const
+        {
+            if (!_const)
+                return &call;
+            else
+                return &call_const;
+        }
+
+#ifndef DOXYGEN_SKIP
+        /*
+         * Invoke the handler of the mem_ptr at \a self without going
+         * through the vtable. Callers select the overload matching the
+         * handler's constness when it is attached. By-value arguments
+         * are taken by rvalue reference and moved into the handler
+         */
+        static R call(void* self, A&&... args)
+        {
+            mem_ptr<R,C,A...>& sig = *static_cast<mem_ptr<R,C,A...>*>(self);
+            return (sig._obj.*sig._func)(std::forward<A>(args)...);
+        }
+
+        static R call_const(void* self, A&&... args)
+        {
+            mem_ptr<R,C,A...>& sig = *static_cast<mem_ptr<R,C,A...>*>(self);
+            return (sig._obj.*sig.const_func())(std::forward<A>(args)...);
+        }
+#endif
+
+    protected:
+
+        template <class Batch, class... T>
+        void run_batch(const Batch& batch, std::size_t n, T*... results)
+        {
+            C* obj = &_obj;
+
+            if (!_const)
+            {
+                const Handler func = _func;
+                auto call = [obj, func](A... args) -> R {
+                    return (obj->*func)(std::forward<A>(args)...);
+                };
+
+                batch_run(call, batch, n, results...);
+            }
+            else
+            {
+                const const_Handler func = const_func();
+                auto call = [obj, func](A... args) -> R {
+                    return (obj->*func)(std::forward<A>(args)...);
+                };
+
+                batch_run(call, batch, n, results...);
+            }
+        }
+
+        /*
+         * A const handler is stored in _func as well, cast to the
+         * non-const type, and cast back here
+         */
+        const_Handler const_func() const
+        {
+            return reinterpret_cast<const_Handler>(_func);
+        }
+
+        template<int... S>
+        R run(seq<S...>)
+        {
+            auto& sargs = this->_sargs;
+            
+            if (sargs.has_refs())
+            {
+                /*
+                 * Dereference stored pointers
+                 */
+                if (!_const)
+                    return (_obj.*_func)(*std::get<S>(sargs.ptrs())...);
+                else
+                    return (_obj.*const_func())(
+                        *std::get<S>(sargs.ptrs())...);
+            }
+            else if (sargs.is_bound_once())
+            {
+                /*
+                 * Move the internal copies into the handler
+                 */
+                if (!_const)
+                    return (_obj.*_func)(
+                        consumed_arg<A>(std::get<S>(sargs.args()))...);
+                else
+                    return (_obj.*const_func())(
+                        consumed_arg<A>(std::get<S>(sargs.args()))...);
+            }
+            else
+            {
+                /*
+                 * Forward the internal copies
+                 */
+                if (!_const)
+                    return (_obj.*_func)( std::get<S>(sargs.args())...);
+                else
+                    return (_obj.*const_func())(
+                        std::get<S>(sargs.args())...);
+            }
+        }
+
+        /*
+         * True if _func is really a const_Handler
+         */
+        bool    _const;
+        Handler _func;
+        C&      _obj;
+    };
+
+    /**
+     ******************************************************************
+     *
+     * @class fcn_ptr
+     *
+     * Represents a signal whose handler is a C-style function pointer
+     *
+     * @tparam R  Signal handler return type
+     * @tparam A  Specifies the type(s) of input arguments required by
+     *            the handler
+     *
+     ******************************************************************
+     */
+    template <class R, class... A>
+    class fcn_ptr : public signal_t<R,A...>
+    {
+        using Handler = R(*)(A...);
+
+    public:
+
+        /**
+         * Default constructor
+         */
+        fcn_ptr() : _func(nullptr)
+        {
+        }
+
+        /**
+         * Construct a fcn_ptr from a handler
+         *
+         * @param[in] func The handler, which is a C-style function
+         *                 pointer
+         */
+        fcn_ptr(const Handler func) : _func(func)
+        {
+        }
+
+        fcn_ptr(const fcn_ptr<R,A...>& other) = default;
+        fcn_ptr(fcn_ptr<R,A...>&& other)      = default;
+
+        /**
+         * Destructor
+         */
+        virtual ~fcn_ptr()
+        {
+        }
+
+        /**
+         * Attach a new signal handler
+         *
+         * @param[in] func The handler, which is a C-style function
+         *                 pointer
+         *
+         * @return True on success
+         */
+        bool attach(const Handler func)
+        {
+            if (func == nullptr)
+                return false;
+
+            _func = func;
+            return true;
+        }
+
+        /**
+         * Bind arguments to the signal handler. This avoids having
+         * to call raise() with explicit inputs
+         *
+         * @note This creates internal copies of \a args to pass to
+         *       the signal handler, moving any that are given as
+         *       rvalues. See \ref forward() if you wish to forward
+         *       references instead
+         *
+         * @param[in] args Input arguments to implicitly forward
+         *                 to the handler
+         */
+        void bind(A... args)
+        {
+            this->_sargs.bind(std::forward<A>(args)...);
+        }
+
+        /**
+         * Bind arguments to the signal handler, to be moved into it
+         * (rather than copied) by the next call to raise(). After that
+         * the bound arguments are left moved-from, so they should be
+         * bound again before raise() is next called without inputs
+         *
+         * @param[in] args Input arguments to implicitly forward
+         *                 to the handler
+         */
+        void bind_once(A... args)
+        {
+            this->_sargs.bind_once(std::forward<A>(args)...);
+        }
+
+        /**
+         * A factory method that creates a copy of this object
+         *
+         * @return A \ref generic pointer to the newly created
+         *         object
+         */
+        generic* clone() const
+        {
+            return new fcn_ptr<R,A...>(*this);
+        }
+
+        /**
+         * A factory method that creates a copy of this object in memory
+         * drawn from \a mem
+         *
+         * @param[in] mem The arena from which to allocate the copy
+         *
+         * @return A \ref generic pointer to the newly created
+         *         object
+         */
+        generic* clone(arena& mem) const
+        {
+            return clone_in(mem, *this);
+        }
+
+        signal_t<R,A...>* copy_to(void* buf) const
+        {
+            return ::new (buf) fcn_ptr<R,A...>(*this);
+        }
+
+        signal_t<R,A...>* move_to(void* buf)
+        {
+            return ::new (buf) fcn_ptr<R,A...>(std::move(*this));
+        }
+
+        signal_t<R,A...>* move_to_heap()
+        {
+            return new fcn_ptr<R,A...>(std::move(*this));
+        }
+
+        /**
+         * Detach the current signal handler
+         *
+         * @return True on success
+         */
+        bool detach()
+        {
+            _func = nullptr;
+            return true;
+        }
+
+        /**
+         * Forward arguments to the signal handler. Unlike \ref bind(),
+         * which forwards copies, this will forward \a args by
+         * reference, e.g. in case they need to be modified within the
+         * signal handler
+         *
+         * @warning
+         * Forwarding references may lead to undefined behavior if you
+         * allow \a args to go out of scope
+         *
+         * @param[in] args Input arguments to implicitly forward
+         */
+        void forward(typename std::remove_reference<A>::type&... args)
+        {
+            this->_sargs.forward(args...);
+        }
+
+        /**
+         * @return True if reference forwarding is enabled
+         */
+        bool has_refs() const
+        {
+            return this->_sargs.has_refs();
+        }
+
+        /**
+         * @return True if the bound arguments will be moved into the
+         *         handler by the next raise(). See \ref bind_once()
+         */
+        bool is_bound_once() const
+        {
+            return this->_sargs.is_bound_once();
+        }
+
+        /**
+         *  Determine if this signal is currently attached
+         *
+         *  @return True if attached
+         */
+        bool is_connected() const
+        {
+            return _func != nullptr;
+        }
+
+        /**
+         * Invoke the signal handler. This will fail if no handler is
+         * attached, which can be verified with is_connected()
+         *
+         * @param[in] args The input arguments to provide the handler
+         *                 with
+         *
+         * @return The return value of the handler
+         */
+        R raise(A... args)
+        {
+            return _func(std::forward<A>(args)...);
+        }
+
+        /**
+         * Forward bound arguments to the signal handler. Note this
+         * will fail if no handler is currently attached, which can
+         * be verified with is_connected()
+         *
+         * @return The return value of the handler
+         */
+        template <int N=0>
+        R raise()
+        {
+            return
+                run(typename gens<sizeof...(A)>::type());
+        }
+
+        /**
+         * Forward bound arguments to the signal handler. Note this
+         * will fail if no handler is currently attached, which can
+         * be verified with is_connected()
+         *
+         * This is equivalent to \ref raise() except that it can be
+         * invoked through a \ref generic
+         */
+        void v_raise()
+        {
+            raise();
+        }
+
+        /**
+         * Invoke the handler once for each entry of a batch of inputs.
+         * The handler is looked up once rather than once per entry
+         *
+         * @param[in] batch Either a pointer to \a n std::tuples, each
+         *                  holding the arguments for one call, or the
+         *                  result of \ref columns()
+         * @param[in] n     The number of entries in \a batch
+         */
+        template <class Batch>
+        void raise_batch(Batch batch, std::size_t n)
+        {
+            run_batch(batch, n);
+        }
+
+        /**
+         * Invoke the handler once for each entry of a batch of inputs,
+         * storing the return values. The handler is looked up once
+         * rather than once per entry
+         *
+         * @param[in]  batch   Either a pointer to \a n std::tuples, each
+         *                     holding the arguments for one call, or the
+         *                     result of \ref columns()
+         * @param[in]  n       The number of entries in \a batch
+         * @param[out] results Receives the return value of each call.
+         *                     This must have room for \a n values
+         */
+        template <class Batch, class T>
+        void raise_batch(Batch batch, std::size_t n, T* results)
+        {
+            run_batch(batch, n, results);
+        }
+
+        /**
+         * @return The thunk that invokes this object's handler
+         */
+        typename signal_t<R,A...>::thunk_type thunk() const
+        {
+            return &call;
+        }
+
+#ifndef DOXYGEN_SKIP
+        /*
+         * Invoke the handler of the fcn_ptr at \a self without going
+         * through the vtable. By-value arguments are taken by rvalue
+         * reference and moved into the handler
+         */
+        static R call(void* self, A&&... args)
+        {
+            return static_cast<fcn_ptr<R,A...>*>(self)->_func(
+                std::forward<A>(args)...);
+        }
+#endif
+
+    protected:
+
+        template <class Batch, class... T>
+        void run_batch(const Batch& batch, std::size_t n, T*... results)
+        {
+            const Handler func = _func;
+            batch_run(func, batch, n, results...);
+        }
+
+        template<int... S>
+        R run(seq<S...>)
+        {
+            auto& sargs = this->_sargs;
+
+            if (sargs.has_refs())
+                return _func(*std::get<S>(sargs.ptrs())... );
+            else if (sargs.is_bound_once())
+                return _func(
+                    consumed_arg<A>(std::get<S>(sargs.args()))...);
+            else
+                return _func( std::get<S>(sargs.args())... );
+        }
+
+        Handler _func;
+    };
+
+#ifndef DOXYGEN_SKIP
+    /*
+     * Holds a callable on the heap, for a Signal whose storage it does
+     * not fit in (or that might throw when moved). Moving one only moves
+     * the pointer
+     */
+    template <class F>
+    class boxed_fcn
+    {
+
+    public:
+
+        template <class T>
+        explicit boxed_fcn(T&& func) : _func(new F(std::forward<T>(func)))
+        {
+        }
+
+        boxed_fcn(const boxed_fcn<F>& other) : _func(new F(*other._func))
+        {
+        }
+
+        boxed_fcn(boxed_fcn<F>&& other) noexcept : _func(other._func)
+        {
+            other._func = nullptr;
+        }
+
+        boxed_fcn<F>& operator=(const boxed_fcn<F>& rhs) = delete;
+
+        ~boxed_fcn()
+        {
+            delete _func;
+        }
+
+        template <class... T>
+        auto operator()(T&&... args)
+            -> decltype(std::declval<F&>()(std::forward<T>(args)...))
+        {
+            return (*_func)(std::forward<T>(args)...);
+        }
+
+    private:
+
+        F* _func;
+    };
+
+    /*
+     * Whether a callable can be copied. A boxed_fcn always declares a
+     * copy constructor, so it defers to the callable it holds
+     */
+    template <class F>
+    struct is_copyable_fcn : std::is_copy_constructible<F>
+    {
+    };
+
+    template <class F>
+    struct is_copyable_fcn<boxed_fcn<F>> : std::is_copy_constructible<F>
+    {
+    };
+
+    /*
+     * Whether an F can be called with arguments of types A... and its
+     * result converted to R (or discarded, if R is void)
+     */
+    template <class F, class R, class... A>
+    class is_callable_as
+    {
+        template <class G, class Ret =
+            decltype(std::declval<G&>()(std::declval<A>()...))>
+        static std::integral_constant<bool, std::is_void<R>::value ||
+            std::is_convertible<Ret,R>::value> test(int);
+
+        template <class G>
+        static std::false_type test(...);
+
+    public:
+
+        static const bool value = decltype(test<F>(0))::value;
+    };
+#endif
+
+    /**
+     ******************************************************************
+     *
+     * @class fcn_obj
+     *
+     * Represents a signal whose handler is a callable object, such as a
+     * lambda or a functor. The callable is stored by value, and may be
+     * move-only, in which case clone() and copy_to() throw
+     * std::logic_error
+     *
+     * @tparam R  Signal handler return type
+     * @tparam F  The type of the callable
+     * @tparam A  Specifies the type(s) of input arguments required by
+     *            the handler
+     *
+     ******************************************************************
+     */
+    template <class R, class F, class... A>
+    class fcn_obj : public signal_t<R,A...>
+    {
+        using copyable = is_copyable_fcn<F>;
+
+    public:
+
         /**
-         * Constructor (3)
+         * Construct a fcn_obj from a callable
          *
-         * @param[in] obj  The object through which to invoke the signal
-         *                 handler
-         * @param[in] func A pointer to the *const* signal handler which
-         *                 is a member of class C
+         * @param[in] func The handler, which is copied or moved into
+         *                 the new object
          */
-        mem_ptr(C& obj, const const_Handler func)
-            : _const_func(func), _forward(false), _func(nullptr),
-              _obj(obj)
+        template <class T>
+        explicit fcn_obj(T&& func) : _func(std::forward<T>(func))
         {
-            _is_init = _const_func != nullptr;
         }
 
+        fcn_obj(const fcn_obj<R,F,A...>& other) = default;
+        fcn_obj(fcn_obj<R,F,A...>&& other)      = default;
+
         /**
          * Destructor
          */
-        virtual ~mem_ptr()
+        virtual ~fcn_obj()
         {
         }
 
         /**
-         * Attach a new signal handler
+         * Bind arguments to the signal handler. This avoids having
+         * to call raise() with explicit inputs
          *
-         * @param[in] func A pointer to the handler which is a member of
-         *                 class C
+         * @note This creates internal copies of \a args to pass to
+         *       the signal handler, moving any that are given as
+         *       rvalues. See \ref forward() if you wish to forward
+         *       references instead
          *
-         * @return True on success
+         * @param[in] args Input arguments to implicitly forward
+         *                 to the handler
          */
-        bool attach(const Handler func)
+        void bind(A... args)
         {
-            if (func == nullptr)
-                return false;
-
-            _func = func;
-            _const_func = nullptr;
-
-            _is_init = true;
-            return true;
+            this->_sargs.bind(std::forward<A>(args)...);
         }
 
         /**
-         * Attach a new signal handler
-         *
-         * @param[in] func A pointer to the *const* signal handler which
-         *                 is a member of class C
+         * Bind arguments to the signal handler, to be moved into it
+         * (rather than copied) by the next call to raise(). After that
+         * the bound arguments are left moved-from, so they should be
+         * bound again before raise() is next called without inputs
          *
-         * @return True on success
+         * @param[in] args Input arguments to implicitly forward
+         *                 to the handler
          */
-        bool attach(const const_Handler func)
+        void bind_once(A... args)
         {
-            if (func == nullptr)
-                return false;
-
-            _func = nullptr;
-            _const_func = func;
-
-            _is_init = true;
-            return true;
+            this->_sargs.bind_once(std::forward<A>(args)...);
         }
 
         /**
-         * Bind arguments to the signal handler. This avoids having
-         * to call raise() with explicit inputs
-         *
-         * @note This creates internal copies of \a args to pass to
-         *       the signal handler. See \ref forward() if you wish
-         *       to forward references instead
+         * A factory method that creates a copy of this object
          *
-         * @param[in] args Input arguments to implicitly forward
-         *                 to the handler
+         * @return A \ref generic pointer to the newly created
+         *         object
          */
-        void bind(A... args)
+        generic* clone() const
         {
-            this->_sargs.args = std::make_tuple(args...);
-            _forward = false;
+            return clone(copyable());
         }
 
         /**
-         * A factory method that creates a copy of this object
+         * A factory method that creates a copy of this object in memory
+         * drawn from \a mem
+         *
+         * @param[in] mem The arena from which to allocate the copy
          *
          * @return A \ref generic pointer to the newly created
          *         object
          */
-        generic* clone() const
+        generic* clone(arena& mem) const
+        {
+            return clone(mem, copyable());
+        }
+
+        signal_t<R,A...>* copy_to(void* buf) const
+        {
+            return copy_to(buf, copyable());
+        }
+
+        signal_t<R,A...>* move_to(void* buf)
         {
-            mem_ptr<R,C,A...>* sig = new mem_ptr<R,C,A...>(_obj);
+            return ::new (buf) fcn_obj<R,F,A...>(std::move(*this));
+        }
 
-            sig->_const_func = _const_func;
-            sig->_forward    = _forward;
-            sig->_func       = _func;
-            sig->_is_init    = _is_init;
-            sig->_sargs      =
-                this->_sargs;
-            return sig;
+        signal_t<R,A...>* move_to_heap()
+        {
+            return new fcn_obj<R,F,A...>(std::move(*this));
         }
 
         /**
-         * Detach the current signal handler
+         * A callable cannot be detached from the object that holds it;
+         * detach the \ref Signal instead
          *
-         * @return True on success
+         * @return False
          */
         bool detach()
         {
-            _const_func = nullptr; _func = nullptr;
-
-            _is_init = false;
-            return true;
+            return false;
         }
 
         /**
@@ -290,8 +1643,7 @@ namespace Signal
          */
         void forward(typename std::remove_reference<A>::type&... args)
         {
-            this->_sargs.ptrs = std::make_tuple(&args...);
-            _forward = true;
+            this->_sargs.forward(args...);
         }
 
         /**
@@ -299,23 +1651,28 @@ namespace Signal
          */
         bool has_refs() const
         {
-            return _forward;
+            return this->_sargs.has_refs();
         }
 
         /**
-         * Determine if this signal is currently attached via \ref
-         * attach()
-         *
-         * @return True if attached
+         * @return True if the bound arguments will be moved into the
+         *         handler by the next raise(). See \ref bind_once()
+         */
+        bool is_bound_once() const
+        {
+            return this->_sargs.is_bound_once();
+        }
+
+        /**
+         * @return True, since the callable is always attached
          */
         bool is_connected() const
         {
-            return !(_const_func == nullptr && _func == nullptr);
+            return true;
         }
 
         /**
-         * Invoke the signal handler. This will fail if no handler is
-         * attached, which can be verified with is_connected()
+         * Invoke the signal handler
          *
          * @param[in] args The input arguments to provide the handler
          *                 with
@@ -324,17 +1681,11 @@ namespace Signal
          */
         R raise(A... args)
         {
-            if (_func != nullptr)
-                return (_obj.*_func)(args...);
-            else
-                return
-                 (_obj.*_const_func)(args...);
+            return invoke(_func, std::forward<A>(args)...);
         }
 
         /**
-         * Forward bound arguments to the signal handler. Note this
-         * will fail if no handler is currently attached, which can
-         * be verified with is_connected()
+         * Forward bound arguments to the signal handler
          *
          * @return The return value of the handler
          */
@@ -346,9 +1697,7 @@ namespace Signal
         }
 
         /**
-         * Forward bound arguments to the signal handler. Note this
-         * will fail if no handler is currently attached, which can
-         * be verified with is_connected()
+         * Forward bound arguments to the signal handler
          *
          * This is equivalent to \ref raise() except that it can be
          * invoked through a \ref generic
@@ -358,248 +1707,330 @@ namespace Signal
             raise();
         }
 
+        /**
+         * Invoke the handler once for each entry of a batch of inputs
+         *
+         * @param[in] batch Either a pointer to \a n std::tuples, each
+         *                  holding the arguments for one call, or the
+         *                  result of \ref columns()
+         * @param[in] n     The number of entries in \a batch
+         */
+        template <class Batch>
+        void raise_batch(Batch batch, std::size_t n)
+        {
+            run_batch(batch, n);
+        }
+
+        /**
+         * Invoke the handler once for each entry of a batch of inputs,
+         * storing the return values
+         *
+         * @param[in]  batch   Either a pointer to \a n std::tuples, each
+         *                     holding the arguments for one call, or the
+         *                     result of \ref columns()
+         * @param[in]  n       The number of entries in \a batch
+         * @param[out] results Receives the return value of each call.
+         *                     This must have room for \a n values
+         */
+        template <class Batch, class T>
+        void raise_batch(Batch batch, std::size_t n, T* results)
+        {
+            run_batch(batch, n, results);
+        }
+
+        /**
+         * @return The thunk that invokes this object's handler
+         */
+        typename signal_t<R,A...>::thunk_type thunk() const
+        {
+            return &call;
+        }
+
+#ifndef DOXYGEN_SKIP
+        /*
+         * Invoke the handler of the fcn_obj at \a self without going
+         * through the vtable. The callable is called directly, so it
+         * may be inlined into the thunk
+         */
+        static R call(void* self, A&&... args)
+        {
+            return invoke(static_cast<fcn_obj<R,F,A...>*>(self)->_func,
+                          std::forward<A>(args)...);
+        }
+#endif
+
     protected:
 
+        /*
+         * Call func, converting its result to R (or discarding it, if
+         * R is void)
+         */
+        template <class... T>
+        static R invoke(F& func, T&&... args)
+        {
+            return static_cast<R>(func(std::forward<T>(args)...));
+        }
+
+        generic* clone(std::true_type) const
+        {
+            return new fcn_obj<R,F,A...>(*this);
+        }
+
+        generic* clone(std::false_type) const
+        {
+            throw std::logic_error("The signal handler cannot be copied");
+        }
+
+        generic* clone(arena& mem, std::true_type) const
+        {
+            return clone_in(mem, *this);
+        }
+
+        generic* clone(arena&, std::false_type) const
+        {
+            throw std::logic_error("The signal handler cannot be copied");
+        }
+
+        signal_t<R,A...>* copy_to(void* buf, std::true_type) const
+        {
+            return ::new (buf) fcn_obj<R,F,A...>(*this);
+        }
+
+        signal_t<R,A...>* copy_to(void*, std::false_type) const
+        {
+            throw std::logic_error("The signal handler cannot be copied");
+        }
+
+        template <class Batch, class... T>
+        void run_batch(const Batch& batch, std::size_t n, T*... results)
+        {
+            F& func = _func;
+
+            auto call = [&func](A... args) -> R {
+                return invoke(func, std::forward<A>(args)...);
+            };
+
+            batch_run(call, batch, n, results...);
+        }
+
         template<int... S>
         R run(seq<S...>)
         {
             auto& sargs = this->_sargs;
-            
-            if (_forward)
-            {
-                /*
-                 * Dereference stored pointers
-                 */
-                if (_func != nullptr)
-                    return (_obj.*_func)(*std::get<S>(sargs.ptrs)...);
-                else
-                    return
-                     (_obj.*_const_func)(*std::get<S>(sargs.ptrs)...);
-            }
+
+            if (sargs.has_refs())
+                return invoke(_func,
+                    stored_arg<A>(*std::get<S>(sargs.ptrs()))...);
+            else if (sargs.is_bound_once())
+                return invoke(_func,
+                    consumed_arg<A>(std::get<S>(sargs.args()))...);
             else
-            {
-                /*
-                 * Forward the internal copies
-                 */
-                if (_func != nullptr)
-                    return (_obj.*_func)( std::get<S>(sargs.args)...);
-                else
-                    return
-                     (_obj.*_const_func)( std::get<S>(sargs.args)...);
-            }
+                return invoke(_func,
+                    stored_arg<A>( std::get<S>(sargs.args()))...);
         }
 
-        const_Handler
-                _const_func;
-        bool    _forward;
-        Handler _func;
-        bool    _is_init;
-        C&      _obj;
+        F _func;
     };
 
     /**
      ******************************************************************
      *
-     * @class fcn_ptr
+     * @class static_fcn
      *
-     * Represents a signal whose handler is a C-style function pointer
+     * A signal whose handler is a C-style function fixed at compile
+     * time. The handler is a template argument rather than a stored
+     * pointer, so raise() is a direct (and usually inlined) call and
+     * the object itself is empty. For example:
      *
-     * @tparam R  Signal handler return type
-     * @tparam A  Specifies the type(s) of input arguments required by
-     *            the handler
+     * @code
+     * Signal::static_fcn<decltype(&handler), &handler> sig;
+     * sig.raise(1);
+     * @endcode
+     *
+     * @tparam F    The type of the handler
+     * @tparam func The handler
      *
      ******************************************************************
      */
-    template <class R, class... A>
-    class fcn_ptr : public signal_t<R,A...>
+    template <class F, F func>
+    class static_fcn;
+
+    template <class R, class... A, R(*func)(A...)>
+    class static_fcn<R(*)(A...), func>
     {
-        using Handler = R(*)(A...);
+        static_assert(func != nullptr, "The handler must not be null");
 
     public:
 
         /**
-         * Default constructor
-         */
-        fcn_ptr()
-            : _forward(false), _func(nullptr), _is_init(false)
-        {
-        }
-
-        /**
-         * Construct a fcn_ptr from a handler
-         *
-         * @param[in] func The handler, which is a C-style function
-         *                 pointer
-         */
-        fcn_ptr(const Handler func)
-            : _forward(false), _func(func)
-        {
-            _is_init  =  _func != nullptr;
-        }
-
-        /**
-         * Destructor
-         */
-        virtual ~fcn_ptr()
-        {
-        }
-
-        /**
-         * Attach a new signal handler
-         *
-         * @param[in] func The handler, which is a C-style function
-         *                 pointer
-         *
-         * @return True on success
+         * @return True, since the handler is always attached
          */
-        bool attach(const Handler func)
+        bool is_connected() const
         {
-            if (func == nullptr)
-                return false;
-
-            _func = func;
-            _is_init = true;
-
             return true;
         }
 
         /**
-         * Bind arguments to the signal handler. This avoids having
-         * to call raise() with explicit inputs
+         * Invoke the signal handler
          *
-         * @note This creates internal copies of \a args to pass to
-         *       the signal handler. See \ref forward() if you wish
-         *       to forward references instead
+         * @param[in] args The input arguments to provide the handler
+         *                 with
          *
-         * @param[in] args Input arguments to implicitly forward
-         *                 to the handler
+         * @return The return value of the handler
          */
-        void bind(A... args)
+        R raise(A... args) const
         {
-            this->_sargs.args = std::make_tuple(args...);
-            _forward = false;
+            return func(std::forward<A>(args)...);
         }
 
         /**
-         * A factory method that creates a copy of this object
+         * Invoke the handler once for each entry of a batch of inputs
          *
-         * @return A \ref generic pointer to the newly created
-         *         object
+         * @param[in] batch Either a pointer to \a n std::tuples, each
+         *                  holding the arguments for one call, or the
+         *                  result of \ref columns()
+         * @param[in] n     The number of entries in \a batch
          */
-        generic* clone() const
+        template <class Batch>
+        void raise_batch(Batch batch, std::size_t n) const
         {
-            fcn_ptr<R,A...>* sig = new fcn_ptr<R,A...>( _func );
+            auto call = [](A... args) -> R {
+                return func(std::forward<A>(args)...);
+            };
 
-            sig->_forward = _forward;
-            sig->_is_init = _is_init;
-            sig->_sargs   =
-                this->_sargs;
-            return sig;
+            batch_run(call, batch, n);
         }
 
         /**
-         * Detach the current signal handler
+         * Invoke the handler once for each entry of a batch of inputs,
+         * storing the return values
          *
-         * @return True on success
+         * @param[in]  batch   See \ref raise_batch()
+         * @param[in]  n       The number of entries in \a batch
+         * @param[out] results Receives the \a n return values
          */
-        bool detach()
+        template <class Batch, class T>
+        void raise_batch(Batch batch, std::size_t n, T* results) const
         {
-            _is_init = false; _func = nullptr;
+            auto call = [](A... args) -> R {
+                return func(std::forward<A>(args)...);
+            };
 
-            return true;
+            batch_run(call, batch, n, results);
         }
+    };
 
-        /**
-         * Forward arguments to the signal handler. Unlike \ref bind(),
-         * which forwards copies, this will forward \a args by
-         * reference, e.g. in case they need to be modified within the
-         * signal handler
-         *
-         * @warning
-         * Forwarding references may lead to undefined behavior if you
-         * allow \a args to go out of scope
-         *
-         * @param[in] args Input arguments to implicitly forward
-         */
-        void forward(typename std::remove_reference<A>::type&... args)
+    /**
+     ******************************************************************
+     *
+     * @class static_mem
+     *
+     * A signal whose handler is a member function fixed at compile
+     * time. Only the object through which to invoke it is stored, so
+     * the object is the size of one pointer. For example:
+     *
+     * @code
+     * Signal::static_mem<decltype(&MyClass::handler),
+     *                    &MyClass::handler> sig(obj);
+     * sig.raise(1);
+     * @endcode
+     *
+     * @tparam F      The type of the handler, which may be a *const*
+     *                member function
+     * @tparam method The handler
+     *
+     ******************************************************************
+     */
+    template <class F, F method>
+    class static_mem;
+
+#ifndef DOXYGEN_SKIP
+    /*
+     * The implementation shared by const and non-const handlers. Obj
+     * is the (possibly const) class through which to invoke method
+     */
+    template <class Obj, class F, F method, class R, class... A>
+    class static_mem_base
+    {
+    public:
+
+        static_mem_base(Obj& obj) : _obj(obj)
         {
-            this->_sargs.ptrs = std::make_tuple(&args...);
-            _forward = true;
         }
 
-        /**
-         * @return True if reference forwarding is enabled
-         */
-        bool has_refs() const
+        bool is_connected() const
         {
-            return _forward;
+            return true;
         }
 
-        /**
-         *  Determine if this signal is currently attached
-         *
-         *  @return True if attached
-         */
-        bool is_connected() const
+        R raise(A... args) const
         {
-            return _func != nullptr;
+            return (_obj.*method)(std::forward<A>(args)...);
         }
 
-        /**
-         * Invoke the signal handler. This will fail if no handler is
-         * attached, which can be verified with is_connected()
-         *
-         * @param[in] args The input arguments to provide the handler
-         *                 with
-         *
-         * @return The return value of the handler
-         */
-        R raise(A... args)
+        template <class Batch>
+        void raise_batch(Batch batch, std::size_t n) const
         {
-            return _func(args...);
+            Obj* obj = &_obj;
+            auto call = [obj](A... args) -> R {
+                return (obj->*method)(std::forward<A>(args)...);
+            };
+
+            batch_run(call, batch, n);
         }
 
-        /**
-         * Forward bound arguments to the signal handler. Note this
-         * will fail if no handler is currently attached, which can
-         * be verified with is_connected()
-         *
-         * @return The return value of the handler
-         */
-        template <int N=0>
-        R raise()
+        template <class Batch, class T>
+        void raise_batch(Batch batch, std::size_t n, T* results) const
         {
-            return
-                run(typename gens<sizeof...(A)>::type());
+            Obj* obj = &_obj;
+            auto call = [obj](A... args) -> R {
+                return (obj->*method)(std::forward<A>(args)...);
+            };
+
+            batch_run(call, batch, n, results);
         }
 
-        /**
-         * Forward bound arguments to the signal handler. Note this
-         * will fail if no handler is currently attached, which can
-         * be verified with is_connected()
-         *
-         * This is equivalent to \ref raise() except that it can be
-         * invoked through a \ref generic
-         */
-        void v_raise()
+    private:
+
+        Obj& _obj;
+    };
+
+    template <class R, class C, class... A, R(C::*method)(A...)>
+    class static_mem<R(C::*)(A...), method>
+        : public static_mem_base<C, R(C::*)(A...), method, R, A...>
+    {
+
+    public:
+
+        static_mem(C& obj)
+            : static_mem_base<C, R(C::*)(A...), method, R, A...>(obj)
         {
-            raise();
         }
+    };
 
-    protected:
+    template <class R, class C, class... A, R(C::*method)(A...) const>
+    class static_mem<R(C::*)(A...) const, method>
+        : public static_mem_base<const C, R(C::*)(A...) const, method,
+                                 R, A...>
+    {
 
-        template<int... S>
-        R run(seq<S...>)
+    public:
+
+        static_mem(const C& obj)
+            : static_mem_base<const C, R(C::*)(A...) const, method,
+                              R, A...>(obj)
         {
-            if (_forward)
-                return _func(*std::get<S>(this->_sargs.ptrs)... );    
-            else
-                return _func( std::get<S>(this->_sargs.args)... );
         }
+    };
+#endif
 
-        bool    _forward;
-        Handler _func;
-        bool    _is_init;
+    /**
+     * What copying a \ref Signal does with its handler
+     */
+    enum class copy_policy
+    {
+        deep,  /**< The copy gets a handler of its own */
+        share  /**< The copy shares the original's handler */
     };
 
     /**
@@ -609,9 +2040,25 @@ namespace Signal
      *
      * Enables the creation of customized "signals" that trigger events
      * of interest which are application-specific. Each Signal wraps
-     * a generic function pointer or class method to be used as a
-     * handler when the Signal is raised, similar to using the standard
-     * signal library
+     * a generic function pointer, class method or callable object to
+     * be used as a handler when the Signal is raised, similar to using
+     * the standard signal library
+     *
+     * The underlying \ref fcn_ptr, \ref mem_ptr or \ref fcn_obj is
+     * constructed in storage embedded within the Signal itself, so
+     * attaching a handler never allocates memory. The one exception is
+     * a callable whose captures take more than SIGNAL_CALLABLE_CAPACITY
+     * bytes, which is moved to the heap. Copying a Signal whose handler
+     * is move-only throws std::logic_error. Otherwise, copying a Signal
+     * copies its handler (and any bound arguments), unless
+     * \ref set_policy() says to share it.
+     * Moving a Signal never allocates, and does not throw as long as
+     * moving its bound arguments does not
+     *
+     * Alongside the handler, each Signal records a thunk specific to
+     * the handler's type (and constness) when it is attached. Raising
+     * a Signal is then a single indirect call through that thunk, with
+     * no virtual dispatch
      *
      * @tparam R  The signal handler's return type
      * @tparam A  Specifies the type(s) of input arguments required by
@@ -622,12 +2069,77 @@ namespace Signal
     template <class R, class... A>
     class Signal : public generic
     {
+        using base_type = signal_t<R,A...>;
+        using raise_fn  = R(*)(void*, A&&...);
+        using shared_type = std::shared_ptr<base_type>;
+
+        /*
+         * Moving a Signal moves its bound arguments
+         */
+        static constexpr bool nothrow_move =
+            std::is_nothrow_move_constructible<SignalArgs<A...>>::value;
+
+        /*
+         * Member function pointers to an arbitrary class are the same
+         * size on any ABI we care about; emplace() verifies this
+         */
+        using mem_type = mem_ptr<R,generic,A...>;
+        using fcn_type = fcn_ptr<R,A...>;
+
+        /*
+         * Room for a fcn_obj whose callable takes up to
+         * SIGNAL_CALLABLE_CAPACITY bytes
+         */
+        static constexpr std::size_t obj_size =
+            sizeof(base_type) + SIGNAL_CALLABLE_CAPACITY;
+
+        static constexpr std::size_t ptr_size =
+            sizeof(mem_type) > sizeof(fcn_type) ?
+                sizeof(mem_type) : sizeof(fcn_type);
+
+        static constexpr std::size_t storage_size =
+            ptr_size > obj_size ? ptr_size : obj_size;
+
+        static constexpr std::size_t storage_align =
+            alignof(mem_type) > alignof(fcn_type) ?
+                alignof(mem_type) : alignof(fcn_type);
+
+        static_assert(sizeof(shared_type)  <= storage_size &&
+                      alignof(shared_type) <= storage_align,
+                      "A shared handle must fit in the Signal's storage");
+
+        /*
+         * Whether a Signal can take a callable of type F as its handler.
+         * Function pointers are left to fcn_ptr, and other Signals to
+         * the copy and move constructors
+         */
+        template <class F, class G = typename std::decay<F>::type>
+        using is_functor = std::integral_constant<bool,
+            !std::is_base_of<generic,G>::value &&
+            !std::is_pointer<G>::value &&
+            is_callable_as<G,R,A...>::value>;
+
+        /*
+         * What a callable of type F is stored as: a fcn_obj holding it
+         * directly if that fits in our storage and can be moved without
+         * throwing, or a fcn_obj holding it on the heap otherwise
+         */
+        template <class F, class G = typename std::decay<F>::type>
+        using obj_type = typename std::conditional<
+            sizeof(fcn_obj<R,G,A...>)  <= storage_size &&
+            alignof(fcn_obj<R,G,A...>) <= storage_align &&
+            std::is_nothrow_move_constructible<G>::value,
+                fcn_obj<R,G,A...>,
+                fcn_obj<R,boxed_fcn<G>,A...>>::type;
+
     public:
 
         /**
          * Default constructor
          */
-        Signal() : _is_mem_ptr(false), _sig()
+        Signal()
+            : _class(nullptr), _policy(copy_policy::deep), _shared(false),
+              _raise(nullptr), _sig(nullptr)
         {
         }
 
@@ -636,9 +2148,27 @@ namespace Signal
          *
          * @param[in] func A pointer to the signal handler
          */
-        Signal(R(*func)(A...)) : _is_mem_ptr(false)
+        Signal(R(*func)(A...))
+            : _class(nullptr), _policy(copy_policy::deep), _shared(false),
+              _raise(nullptr), _sig(nullptr)
+        {
+            emplace<fcn_ptr<R,A...>>(&fcn_ptr<R,A...>::call, func);
+        }
+
+        /**
+         * Create a signal whose handler is a callable object, such as a
+         * lambda. The callable may be move-only
+         *
+         * @param[in] func The handler, which is copied or moved into
+         *                 the Signal
+         */
+        template <class F, class = typename std::enable_if<
+                               is_functor<F>::value>::type>
+        Signal(F&& func)
+            : _class(nullptr), _policy(copy_policy::deep), _shared(false),
+              _raise(nullptr), _sig(nullptr)
         {
-            _sig.reset(new fcn_ptr<R,A...>(func));
+            emplace<obj_type<F>>(&obj_type<F>::call, std::forward<F>(func));
         }
 
         /**
@@ -652,9 +2182,12 @@ namespace Signal
          *                 to class C
          */
         template <typename C>
-        Signal(C& obj, R(C::*func)(A...)) : _is_mem_ptr(true)
+        Signal(C& obj, R(C::*func)(A...))
+            : _class(&class_id<C>::tag), _policy(copy_policy::deep),
+              _shared(false), _raise(nullptr), _sig(nullptr)
         {
-            _sig.reset(new mem_ptr<R,C,A...>(obj, func));
+            emplace<mem_ptr<R,C,A...>>(&mem_ptr<R,C,A...>::call,
+                                       obj, func);
         }
 
         /**
@@ -668,19 +2201,25 @@ namespace Signal
          *                 belongs to class C
          */
         template <typename C>
-        Signal(C& obj, R(C::*func)(A...) const) : _is_mem_ptr(true)
+        Signal(C& obj, R(C::*func)(A...) const)
+            : _class(&class_id<C>::tag), _policy(copy_policy::deep),
+              _shared(false), _raise(nullptr), _sig(nullptr)
         {
-            _sig.reset(new mem_ptr<R,C,A...>(obj, func));
+            emplace<mem_ptr<R,C,A...>>(&mem_ptr<R,C,A...>::call_const,
+                                       obj, func);
         }
 
         /**
-         * Copy constructor
+         * Copy constructor. The copy has the same copy policy as \a
+         * other, and either a copy of its handler or a share of it
          *
          * @param [in] other The Signal of which *this will be a copy
          */
         Signal(const Signal<R,A...>& other)
+            : _class(nullptr), _policy(other._policy), _shared(false),
+              _raise(nullptr), _sig(nullptr)
         {
-            *this = other;
+            copy_from(other);
         }
 
         /**
@@ -689,15 +2228,20 @@ namespace Signal
          * @param [in] other A Signal to move into *this. This leaves
          *                   \a other detached
          */
-        Signal(Signal<R,A...>&& other)
+        Signal(Signal<R,A...>&& other) noexcept(nothrow_move)
+            : _class(nullptr), _policy(other._policy), _shared(false),
+              _raise(nullptr), _sig(nullptr)
         {
-            *this = std::move( other );
+            move_from(other);
         }
 
         /**
          * Destructor
          */
-        virtual ~Signal() {}
+        virtual ~Signal()
+        {
+            destroy();
+        }
 
         /**
          * Copy assignment operator
@@ -710,10 +2254,10 @@ namespace Signal
         {
             if (this != &rhs)
             {
-                // Is implicitly deleted by move assignment:
+                destroy();
 
-                _is_mem_ptr = rhs._is_mem_ptr;
-                _sig        = rhs._sig;
+                _policy = rhs._policy;
+                copy_from(rhs);
             }
 
             return *this;
@@ -728,14 +2272,14 @@ namespace Signal
          * @return *this
          */
         Signal<R,A...>& operator=(Signal<R,A...>&& rhs)
+            noexcept(nothrow_move)
         {
             if (this != &rhs)
             {
-                _is_mem_ptr = rhs._is_mem_ptr;
-                
-                _sig  = std::move( rhs._sig );
+                destroy();
 
-                rhs._is_mem_ptr = false;
+                _policy = rhs._policy;
+                move_from(rhs);
             }
 
             return *this;
@@ -754,12 +2298,35 @@ namespace Signal
             if (is_connected() && !detach())
                 return false;
 
-            _sig.reset(new fcn_ptr<R,A...>(func));
-            _is_mem_ptr = false;
+            emplace<fcn_ptr<R,A...>>(&fcn_ptr<R,A...>::call, func);
+            _class = nullptr;
 
             return _sig->is_connected();
         }
 
+        /**
+         * Attach a handler to this Signal, removing the previous
+         * handler (if it exists)
+         *
+         * @param[in] func The handler, which is a callable object such
+         *                 as a lambda. It is copied or moved into the
+         *                 Signal, and may be move-only
+         *
+         * @return True if the handler was successfully attached
+         */
+        template <class F, class = typename std::enable_if<
+                               is_functor<F>::value>::type>
+        bool attach(F&& func)
+        {
+            if (is_connected() && !detach())
+                return false;
+
+            emplace<obj_type<F>>(&obj_type<F>::call, std::forward<F>(func));
+            _class = nullptr;
+
+            return true;
+        }
+
         /**
          * Attach a handler to this Signal, removing the previous
          * handler (if it exists)
@@ -779,8 +2346,9 @@ namespace Signal
                 return false;
             else
             {
-                _sig.reset(new mem_ptr<R,C,A...>(obj, func));
-                _is_mem_ptr = true;
+                emplace<mem_ptr<R,C,A...>>(&mem_ptr<R,C,A...>::call,
+                                           obj, func);
+                _class = &class_id<C>::tag;
             }
 
             return _sig->is_connected();
@@ -790,7 +2358,8 @@ namespace Signal
          * Associate a new handler with this Signal without changing 
          * the object through which it is called. This method will
          * fail if this signal was not initialized with an object of
-         * class C
+         * class C. If the handler is shared (see \ref set_policy()),
+         * every Signal sharing it is re-targeted
          *
          * @tparam C Class that implements the signal handler 
          *
@@ -801,11 +2370,14 @@ namespace Signal
         template <typename C>
         bool attach(R(C::*func)(A...))
         {
-            if (!_is_mem_ptr || !is_connected())
+            if (_class != &class_id<C>::tag || !is_connected())
                 return false;
-            else
-                std::dynamic_pointer_cast<
-                    mem_ptr<R,C,A...>>(_sig)->attach(func);
+
+            auto sig = static_cast<mem_ptr<R,C,A...>*>(_sig);
+            if (!sig->attach(func))
+                return false;
+            else if (!_shared)
+                _raise = &mem_ptr<R,C,A...>::call;
 
             return _sig->is_connected();
         }
@@ -829,8 +2401,9 @@ namespace Signal
                 return false;
             else
             {
-                _sig.reset(new mem_ptr<R,C,A...>(obj, func));
-                _is_mem_ptr = true;
+                emplace<mem_ptr<R,C,A...>>(
+                    &mem_ptr<R,C,A...>::call_const, obj, func);
+                _class = &class_id<C>::tag;
             }
 
             return _sig->is_connected();
@@ -840,7 +2413,8 @@ namespace Signal
          * Associate a new handler with this Signal without changing 
          * the object through which it is called. This method will
          * fail if this signal was not initialized with an object of
-         * class C
+         * class C. If the handler is shared (see \ref set_policy()),
+         * every Signal sharing it is re-targeted
          *
          * @tparam C The class that implements the signal handler 
          *
@@ -851,11 +2425,14 @@ namespace Signal
         template <typename C>
         bool attach(R(C::*func)(A...) const)
         {
-            if (!_is_mem_ptr || !is_connected())
+            if (_class != &class_id<C>::tag || !is_connected())
                 return false;
-            else
-                std::dynamic_pointer_cast<
-                    mem_ptr<R,C,A...>>(_sig)->attach(func);
+
+            auto sig = static_cast<mem_ptr<R,C,A...>*>(_sig);
+            if (!sig->attach(func))
+                return false;
+            else if (!_shared)
+                _raise = &mem_ptr<R,C,A...>::call_const;
 
             return _sig->is_connected();
         }
@@ -865,15 +2442,30 @@ namespace Signal
          * to call raise() with explicit inputs
          *
          * @note This creates internal copies of \a args to pass to
-         *       the signal handler. See \ref forward() if you wish
-         *       to forward references instead
+         *       the signal handler, moving any that are given as
+         *       rvalues. See \ref forward() if you wish to forward
+         *       references instead
          *
          * @param[in] args Input arguments to implicitly forward
          *                 to the handler
          */
         void bind(A... args)
         {
-            _sig->bind(args...);
+            _sig->bind(std::forward<A>(args)...);
+        }
+
+        /**
+         * Bind arguments to the signal handler, to be moved into it
+         * (rather than copied) by the next call to raise(). After that
+         * the bound arguments are left moved-from, so they should be
+         * bound again before raise() is next called without inputs
+         *
+         * @param[in] args Input arguments to implicitly forward
+         *                 to the handler
+         */
+        void bind_once(A... args)
+        {
+            _sig->bind_once(std::forward<A>(args)...);
         }
 
         /**
@@ -887,6 +2479,20 @@ namespace Signal
             return new Signal(*this);
         }
 
+        /**
+         * A factory method that creates a copy of this object in memory
+         * drawn from \a mem
+         *
+         * @param[in] mem The arena from which to allocate the copy
+         *
+         * @return A \ref generic pointer to the newly created
+         *         object
+         */
+        virtual generic* clone(arena& mem) const
+        {
+            return clone_in(mem, *this);
+        }
+
         /**
          * Detach a signal handler
          *
@@ -896,8 +2502,8 @@ namespace Signal
         {
             if (!_sig) return false;
 
-            _sig.reset();
-                _is_mem_ptr = false;
+            destroy();
+                _class = nullptr;
 
             return true;
         }
@@ -932,6 +2538,14 @@ namespace Signal
             return _sig->is_connected();
         }
 
+        /**
+         * @return What copying this Signal does with its handler
+         */
+        copy_policy policy() const
+        {
+            return _policy;
+        }
+
         /**
          * Forward a set of arguments to the signal handler. This will
          * fail if a handler is not attached. Use is_connected() to
@@ -939,6 +2553,10 @@ namespace Signal
          * on a detached signal will raise a seg fault (which probably
          * isn't the signal you intended)
          *
+         * Arguments are forwarded to the handler without further
+         * copies: a by-value argument is copied (or moved) once into
+         * this call and then moved into the handler
+         *
          * @param [in] args The input arguments to provide the handler
          *                  with
          * 
@@ -946,7 +2564,10 @@ namespace Signal
          */
         R raise(A... args)
         {
-            return _sig->raise(args...);
+#ifdef SIGNAL_INSTRUMENT
+            stats::timer timer(_stats);
+#endif
+            return _raise(_storage, std::forward<A>(args)...);
         }
 
         /**
@@ -959,6 +2580,9 @@ namespace Signal
         template <int N=0>
         R raise()
         {
+#ifdef SIGNAL_INSTRUMENT
+            stats::timer timer(_stats);
+#endif
             return
                 run(typename gens<sizeof...(A)>::type());
         }
@@ -976,28 +2600,288 @@ namespace Signal
             raise();
         }
 
-        /*
-        Signal(const Signal<R,A...>& rhs)        = delete;
-        Signal<R,A...>&
-            operator=(const Signal<R,A...>& rhs) = delete;
+        /**
+         * Invoke the handler once for each entry of a batch of inputs.
+         * The handler is looked up once rather than once per entry
+         *
+         * @param[in] batch Either a pointer to \a n std::tuples, each
+         *                  holding the arguments for one call, or the
+         *                  result of \ref columns()
+         * @param[in] n     The number of entries in \a batch
+         */
+        template <class Batch>
+        void raise_batch(Batch batch, std::size_t n)
+        {
+            run_batch(batch, n);
+        }
+
+        /**
+         * Invoke the handler once for each entry of a batch of inputs,
+         * storing the return values. The handler is looked up once
+         * rather than once per entry
+         *
+         * @param[in]  batch   Either a pointer to \a n std::tuples, each
+         *                     holding the arguments for one call, or the
+         *                     result of \ref columns()
+         * @param[in]  n       The number of entries in \a batch
+         * @param[out] results Receives the return value of each call.
+         *                     This must have room for \a n values
+         */
+        template <class Batch, class T>
+        void raise_batch(Batch batch, std::size_t n, T* results)
+        {
+            run_batch(batch, n, results);
+        }
+
+        /**
+         * Choose what copying this Signal does with its handler
+         *
+         * With copy_policy::share, the handler is moved to the heap and
+         * every copy refers to it. Binding arguments to, or re-targeting
+         * any of them affects them all, while attaching a new handler
+         * with attach(func) or attach(obj, func) gives that one Signal a
+         * handler of its own. Switching back to copy_policy::deep gives
+         * this Signal a private copy of the handler, or the handler
+         * itself if no other Signal shares it. Move-only handlers can be
+         * shared, but then copies throw std::logic_error when switched
+         * back to copy_policy::deep while still shared
+         *
+         * @param[in] policy The new policy, which copies inherit
+         */
+        void set_policy(copy_policy policy)
+        {
+            if (policy == copy_policy::share)
+                share();
+            else
+                unshare();
+
+            _policy = policy;
+        }
+
+#ifdef SIGNAL_INSTRUMENT
+        /**
+         * Record the call count and latency of every raise of this
+         * Signal. Copies of this Signal record into the same stats.
+         * Only available when compiled with SIGNAL_INSTRUMENT
+         *
+         * @param[in] s Where to record, or null to stop recording.
+         *              This must outlive the Signal and its copies
+         */
+        void set_stats(stats* s)
+        {
+            _stats = s;
+        }
+
+        /**
+         * @return Where raises of this Signal are being recorded, or
+         *         null if they are not
          */
+        stats* get_stats() const
+        {
+            return _stats;
+        }
+#endif
 
     private:
 
+        /*
+         * Invoke a handler shared with other Signals. This goes through
+         * the vtable, since any of them may re-target the handler
+         */
+        static R call_shared(void* self, A&&... args)
+        {
+            return (*static_cast<shared_type*>(self))->raise(
+                std::forward<A>(args)...);
+        }
+
+        void copy_from(const Signal<R,A...>& other)
+        {
+            if (other._shared)
+            {
+                ::new (static_cast<void*>(_storage))
+                    shared_type(other.handle());
+                _sig    = other._sig;
+                _shared = true;
+            }
+            else if (other._sig)
+                _sig = other._sig->copy_to(_storage);
+
+            _class = other._class;
+            _raise = other._raise;
+#ifdef SIGNAL_INSTRUMENT
+            _stats = other._stats;
+#endif
+        }
+
+        void destroy()
+        {
+            if (_sig)
+            {
+                if (_shared)
+                    handle().~shared_type();
+                else
+                    _sig->~base_type();
+
+                _shared = false;
+                _sig    = nullptr;
+                _raise  = nullptr;
+            }
+        }
+
+        shared_type& handle()
+        {
+            return *reinterpret_cast<shared_type*>(_storage);
+        }
+
+        const shared_type& handle() const
+        {
+            return *reinterpret_cast<const shared_type*>(_storage);
+        }
+
+        void move_from(Signal<R,A...>& other) noexcept(nothrow_move)
+        {
+            if (other._shared)
+            {
+                ::new (static_cast<void*>(_storage))
+                    shared_type(std::move(other.handle()));
+                _sig    = other._sig;
+                _shared = true;
+            }
+            else if (other._sig)
+                _sig = other._sig->move_to(_storage);
+
+            _class = other._class;
+            _raise = other._raise;
+#ifdef SIGNAL_INSTRUMENT
+            _stats = other._stats;
+#endif
+
+            other.detach();
+        }
+
+        /*
+         * Move our handler to the heap, where copies can share it
+         */
+        void share()
+        {
+            if (_shared || !_sig)
+                return;
+
+            shared_type shared(_sig->move_to_heap());
+            _sig->~base_type();
+
+            ::new (static_cast<void*>(_storage))
+                shared_type(std::move(shared));
+
+            _raise  = &call_shared;
+            _shared = true;
+            _sig    = handle().get();
+        }
+
+        /*
+         * Replace a shared handler with one of our own, which is moved
+         * back into our storage if no other Signal shares it
+         */
+        void unshare()
+        {
+            if (!_shared)
+                return;
+
+            shared_type shared(std::move(handle()));
+            handle().~shared_type();
+
+            try
+            {
+                if (shared.use_count() == 1)
+                    _sig = shared->move_to(_storage);
+                else
+                    _sig = shared->copy_to(_storage);
+            }
+            catch (...)
+            {
+                ::new (static_cast<void*>(_storage))
+                    shared_type(std::move(shared));
+                throw;
+            }
+
+            _shared = false;
+            _raise  = _sig->thunk();
+        }
+
+        /*
+         * Construct a handler of type S in our storage. The handler
+         * always begins at _storage, which is what gets passed to
+         * the thunk \a fn on each raise
+         */
+        template <class S, class... T>
+        void emplace(raise_fn fn, T&&... args)
+        {
+            static_assert(sizeof(S)  <= storage_size &&
+                          alignof(S) <= storage_align,
+                          "Handler does not fit in the Signal's storage");
+
+            destroy();
+            _sig = ::new (static_cast<void*>(_storage))
+                S(std::forward<T>(args)...);
+            _raise = fn;
+
+            if (_policy == copy_policy::share)
+                share();
+        }
+
+        template <class Batch, class... T>
+        void run_batch(const Batch& batch, std::size_t n, T*... results)
+        {
+            const raise_fn fn = _raise;
+            void* target = _storage;
+
+            auto call = [fn, target](A... args) -> R {
+                return fn(target, std::forward<A>(args)...);
+            };
+
+            batch_run(call, batch, n, results...);
+        }
+
         template<int... S>
         R run(seq<S...>)
         {
             auto& _sargs = _sig->_sargs;
-            if (_sig->has_refs())
-                return _sig->raise(*std::get<S>(_sargs.ptrs)... );
+            if (_sargs.has_refs())
+                return _raise(_storage,
+                    stored_arg<A>(*std::get<S>(_sargs.ptrs()))...);
+            else if (_sargs.is_bound_once())
+                return _raise(_storage,
+                    consumed_arg<A>(std::get<S>(_sargs.args()))...);
             else
-                return _sig->raise( std::get<S>(_sargs.args)... );
+                return _raise(_storage,
+                    stored_arg<A>( std::get<S>(_sargs.args()))...);
         }
 
-        bool _is_mem_ptr;
+        /*
+         * class_id<C>::tag if the handler is a member of class C, or
+         * null otherwise
+         */
+        const char* _class;
+
+        copy_policy _policy;
+
+        /*
+         * True if our storage holds a shared_type that owns the handler
+         * rather than the handler itself. Kept next to _policy so that
+         * the two share one word
+         */
+        bool _shared;
+
+        raise_fn _raise;
+
+        base_type* _sig;
+
+#ifdef SIGNAL_INSTRUMENT
+        stats* _stats = nullptr;
+#endif
 
-        std::shared_ptr< signal_t<R,A...> >
-            _sig;
+        alignas(storage_align) unsigned char
+            _storage[storage_size];
     };
 
     /**
@@ -1093,6 +2977,38 @@ namespace Signal
             return _handler(std::forward<T>(args)...);
         }
 
+        /**
+         * Invoke the signal handler once for each entry of a batch of
+         * inputs
+         *
+         * @param[in] batch Either a pointer to \a n std::tuples, each
+         *                  holding the arguments for one call, or the
+         *                  result of \ref columns()
+         * @param[in] n     The number of entries in \a batch
+         */
+        template <class Batch>
+        void raise_batch(Batch batch, std::size_t n)
+        {
+            batch_run(_handler, batch, n);
+        }
+
+        /**
+         * Invoke the signal handler once for each entry of a batch of
+         * inputs, storing the return values
+         *
+         * @param[in]  batch   Either a pointer to \a n std::tuples, each
+         *                     holding the arguments for one call, or the
+         *                     result of \ref columns()
+         * @param[in]  n       The number of entries in \a batch
+         * @param[out] results Receives the return value of each call.
+         *                     This must have room for \a n values
+         */
+        template <class Batch, class T>
+        void raise_batch(Batch batch, std::size_t n, T* results)
+        {
+            batch_run(_handler, batch, n, results);
+        }
+
     private:
 
         Func _handler;
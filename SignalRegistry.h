@@ -0,0 +1,247 @@
+/**
+ *  \file   SignalRegistry.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __SIGNAL_REGISTRY_H__
+#define __SIGNAL_REGISTRY_H__
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "Signal.h"
+
+namespace Signal
+{
+    /**
+     ******************************************************************
+     *
+     * @class SignalRegistry
+     *
+     * A container of signals of any type, each of which is accessed
+     * through the \ref generic interface. Signals are identified by
+     * dense integer IDs, assigned in the order in which they are
+     * added, so looking one up is an array index
+     *
+     * The signals themselves are packed one after another into large
+     * chunks of memory, which keeps raise_all() walking memory in
+     * order instead of chasing pointers across the heap. Signals are
+     * never moved once added
+     *
+     ******************************************************************
+     */
+    class SignalRegistry
+    {
+        /*
+         * Hands out consecutive pieces of large chunks. Memory is only
+         * reclaimed when the registry is cleared
+         */
+        class chunk_arena : public arena
+        {
+
+        public:
+
+            explicit chunk_arena(std::size_t chunk_size)
+                : _chunk_size(chunk_size), _chunks(), _left(0),
+                  _next(nullptr)
+            {
+            }
+
+            ~chunk_arena()
+            {
+                release();
+            }
+
+            void* allocate(std::size_t size, std::size_t align)
+            {
+                if (align > alignof(std::max_align_t))
+                    throw std::bad_alloc();
+
+                const std::size_t pad =
+                    (align - reinterpret_cast<std::size_t>(_next) % align)
+                        % align;
+
+                if (_next == nullptr || pad + size > _left)
+                {
+                    const std::size_t bytes =
+                        size > _chunk_size ? size : _chunk_size;
+
+                    _chunks.push_back(::operator new(bytes));
+
+                    _next = static_cast<unsigned char*>(_chunks.back());
+                    _left = bytes;
+
+                    return take(size);
+                }
+
+                _next += pad; _left -= pad;
+                return take(size);
+            }
+
+            void deallocate(void*)
+            {
+            }
+
+            void release()
+            {
+                for (std::size_t i = 0; i < _chunks.size(); i++)
+                    ::operator delete(_chunks[i]);
+
+                _chunks.clear();
+                _left = 0; _next = nullptr;
+            }
+
+        private:
+
+            void* take(std::size_t size)
+            {
+                void* ptr = _next;
+                _next += size; _left -= size;
+                return ptr;
+            }
+
+            const std::size_t _chunk_size;
+
+            std::vector<void*>
+                _chunks;
+
+            std::size_t _left;
+
+            unsigned char* _next;
+        };
+
+    public:
+
+        /**
+         * Constructor
+         *
+         * @param[in] chunk_size The number of bytes to reserve from the
+         *                       heap at a time
+         */
+        explicit SignalRegistry(std::size_t chunk_size = 4096)
+            : _arena(chunk_size), _signals()
+        {
+        }
+
+        SignalRegistry(const SignalRegistry& other)          = delete;
+        SignalRegistry& operator=(const SignalRegistry& rhs) = delete;
+
+        /**
+         * Destructor. Destroys every signal in the registry
+         */
+        ~SignalRegistry()
+        {
+            clear();
+        }
+
+        /**
+         * Add a copy of a signal to the registry
+         *
+         * @param[in] sig The signal to copy
+         *
+         * @return The ID of the copy
+         */
+        std::size_t add(const generic& sig)
+        {
+            _signals.push_back(sig.clone(_arena));
+
+            return _signals.size() - 1;
+        }
+
+        /**
+         * Construct a signal of type S directly in the registry
+         *
+         * @tparam S The type of signal, which derives from \ref generic
+         *
+         * @param[in] args The arguments to pass to the constructor of S
+         *
+         * @return The ID of the new signal
+         */
+        template <class S, class... T>
+        std::size_t emplace(T&&... args)
+        {
+            void* buf = _arena.allocate(sizeof(S), alignof(S));
+            _signals.push_back(::new (buf) S(std::forward<T>(args)...));
+
+            return _signals.size() - 1;
+        }
+
+        /**
+         * Destroy every signal in the registry and release its memory.
+         * IDs are assigned from zero again afterwards
+         */
+        void clear()
+        {
+            for (std::size_t i = 0; i < _signals.size(); i++)
+                _signals[i]->~generic();
+
+            _signals.clear();
+            _arena.release();
+        }
+
+        /**
+         * Get a signal from the registry
+         *
+         * @param[in] id The signal's ID, which must be less than size()
+         *
+         * @return The signal
+         */
+        generic& get(std::size_t id)
+        {
+            return *_signals[id];
+        }
+
+        /**
+         * Get a signal from the registry
+         *
+         * @param[in] id The signal's ID, which must be less than size()
+         *
+         * @return The signal
+         */
+        const generic& get(std::size_t id) const
+        {
+            return *_signals[id];
+        }
+
+        /**
+         * Forward bound arguments to the handler(s) of one signal
+         *
+         * @param[in] id The signal's ID, which must be less than size()
+         */
+        void raise(std::size_t id)
+        {
+            _signals[id]->v_raise();
+        }
+
+        /**
+         * Forward bound arguments to the handler(s) of every signal, in
+         * the order in which the signals were added
+         */
+        void raise_all()
+        {
+            for (std::size_t i = 0; i < _signals.size(); i++)
+                _signals[i]->v_raise();
+        }
+
+        /**
+         * @return The number of signals in the registry
+         */
+        std::size_t size() const
+        {
+            return _signals.size();
+        }
+
+    private:
+
+        chunk_arena _arena;
+
+        std::vector<generic*>
+            _signals;
+    };
+}
+
+#endif // __SIGNAL_REGISTRY_H__
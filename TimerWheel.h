@@ -0,0 +1,704 @@
+/**
+ *  \file   TimerWheel.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+#include "Signal.h"
+
+namespace Signal
+{
+    /**
+     ******************************************************************
+     *
+     * @class timer
+     *
+     * Identifies a single timer scheduled on a \ref TimerWheel. This is
+     * what you pass to TimerWheel::cancel() to remove it
+     *
+     ******************************************************************
+     */
+    class timer
+    {
+
+    public:
+
+        /**
+         * Default constructor. Creates a timer that refers to nothing
+         */
+        timer() : _id(0)
+        {
+        }
+
+        /**
+         * Constructor
+         *
+         * @param[in] id The unique (per wheel) ID of the timer
+         */
+        explicit timer(std::uint64_t id) : _id(id)
+        {
+        }
+
+        /**
+         * @return The ID of the timer
+         */
+        std::uint64_t id() const
+        {
+            return _id;
+        }
+
+        /**
+         * @return True if this timer was returned by a schedule()
+         */
+        bool is_valid() const
+        {
+            return _id != 0;
+        }
+
+        bool operator==(const timer& rhs) const
+        {
+            return _id == rhs._id;
+        }
+
+        bool operator!=(const timer& rhs) const
+        {
+            return _id != rhs._id;
+        }
+
+    private:
+
+        std::uint64_t _id;
+    };
+
+    /**
+     ******************************************************************
+     *
+     * @class TimerWheel
+     *
+     * Raises signals after a delay, or periodically, by calling their
+     * v_raise(), so they should have their arguments bound. For
+     * example:
+     *
+     * @code
+     * Signal::TimerWheel wheel(std::chrono::milliseconds(1));
+     *
+     * Signal::Signal<void,int> sig(&handler);
+     * sig.bind(42);
+     *
+     * wheel.schedule(&sig, std::chrono::milliseconds(250));
+     * wheel.schedule(sig, std::chrono::seconds(1),
+     *                     std::chrono::seconds(1));
+     * @endcode
+     *
+     * Time is counted in ticks of a fixed length, and delays are rounded
+     * up to a whole number of ticks. Timers are kept in 4 levels of 256
+     * slots each: level 0 holds the timers due within 256 ticks, one
+     * slot per tick, and each level above covers 256 times the span of
+     * the one below. Scheduling or cancelling a timer is O(1), and a
+     * timer is moved down at most 3 times before it fires. Timers due
+     * more than 2^32 ticks out are parked in the top level until they
+     * come within range
+     *
+     * Time advances with tick(), with advance() (which reads a clock),
+     * or, on Linux, by registering fd() with a \ref Reactor and calling
+     * on_ready() when it is readable. Timers due on the same tick fire
+     * in the order in which they were scheduled, except that timers
+     * moved down from a higher level go after them
+     *
+     * Handlers may schedule and cancel timers, including their own
+     *
+     * @note A TimerWheel is not thread-safe
+     *
+     ******************************************************************
+     */
+    class TimerWheel
+    {
+        static const unsigned bits   = 8;
+        static const unsigned levels = 4;
+        static const unsigned slots  = 1u << bits;
+        static const unsigned mask   = slots - 1;
+
+        static const std::uint32_t nil = ~std::uint32_t(0);
+        static const std::uint16_t unlinked = ~std::uint16_t(0);
+
+        /*
+         * The furthest ahead, in ticks, that a timer can be placed
+         */
+        static const std::uint64_t span =
+            (std::uint64_t(1) << (bits * levels)) - 1;
+
+        struct node
+        {
+            generic* sig;
+
+            std::uint64_t expiry;
+            std::uint64_t period;
+
+            std::uint32_t next;
+            std::uint32_t prev;
+
+            std::uint32_t generation;
+
+            /*
+             * The index of the list holding this timer, or unlinked
+             */
+            std::uint16_t list;
+
+            bool owned;
+        };
+
+        /*
+         * Releases the timer being fired once its signal returns, even
+         * if it throws
+         */
+        class firing_guard
+        {
+
+        public:
+
+            firing_guard(TimerWheel& wheel, std::uint32_t index)
+                : _previous(wheel._firing), _wheel(wheel)
+            {
+                _wheel._firing = index;
+            }
+
+            ~firing_guard()
+            {
+                const std::uint32_t index = _wheel._firing;
+                _wheel._firing = _previous;
+
+                if (_wheel._nodes[index].list == unlinked)
+                    _wheel.release(index);
+            }
+
+        private:
+
+            const std::uint32_t _previous;
+
+            TimerWheel& _wheel;
+        };
+
+    public:
+
+        typedef std::chrono::steady_clock clock;
+
+        /**
+         * Constructor
+         *
+         * @param[in] tick The length of a tick, which is the resolution
+         *                 of every timer
+         */
+        explicit TimerWheel(
+            clock::duration tick = std::chrono::milliseconds(1))
+            : _fd(-1), _firing(nil), _free(nil), _nodes(), _now(0),
+              _size(0), _start(clock::now()),
+              _tick(tick.count() > 0 ? tick : clock::duration(1))
+        {
+            for (std::size_t i = 0; i < levels * slots; i++)
+                _heads[i] = nil;
+        }
+
+        TimerWheel(const TimerWheel& other)            = delete;
+        TimerWheel& operator=(const TimerWheel& rhs)   = delete;
+
+        /**
+         * Destructor. Destroys the copies made by schedule(const
+         * generic&, ...) of timers that have not fired
+         */
+        ~TimerWheel()
+        {
+            for (std::size_t i = 0; i < _nodes.size(); i++)
+            {
+                if (_nodes[i].owned)
+                    delete _nodes[i].sig;
+            }
+
+#if defined(__linux__)
+            if (_fd != -1)
+                ::close(_fd);
+#endif
+        }
+
+        /**
+         * Advance to the time \a now, firing every timer that has come
+         * due. Time is measured from the wheel's construction
+         *
+         * @param[in] now The current time
+         *
+         * @return The number of timers fired
+         */
+        std::size_t advance(clock::time_point now = clock::now())
+        {
+            const std::uint64_t target =
+                static_cast<std::uint64_t>((now - _start) / _tick);
+
+            return target > _now ? tick(target - _now) : 0;
+        }
+
+        /**
+         * Cancel a timer
+         *
+         * @param[in] t The timer
+         *
+         * @return True if the timer was pending, or false if it already
+         *         fired (for the last time) or was cancelled
+         */
+        bool cancel(const timer& t)
+        {
+            const std::uint32_t index = find(t);
+            if (index == nil || _nodes[index].list == unlinked)
+                return false;
+
+            unlink(index);
+
+            if (index != _firing)
+                release(index);
+
+            return true;
+        }
+
+#if defined(__linux__)
+        /**
+         * Get a timerfd that becomes readable once per tick while any
+         * timer is pending, for waiting on with epoll or a \ref Reactor.
+         * Call on_ready() whenever it is readable
+         *
+         * @return The file descriptor, which the wheel owns, or -1 on
+         *         error
+         */
+        int fd()
+        {
+            if (_fd == -1)
+            {
+                _fd = ::timerfd_create(CLOCK_MONOTONIC,
+                                       TFD_NONBLOCK | TFD_CLOEXEC);
+                if (_fd != -1 && _size > 0)
+                    arm(true);
+            }
+
+            return _fd;
+        }
+
+        /**
+         * Advance by the number of ticks that have elapsed on the
+         * timerfd returned by fd(), firing every timer that has come due
+         *
+         * @return The number of timers fired
+         */
+        std::size_t on_ready()
+        {
+            std::uint64_t expirations = 0;
+            if (::read(_fd, &expirations, sizeof(expirations)) !=
+                sizeof(expirations))
+            {
+                return 0;
+            }
+
+            return tick(expirations);
+        }
+#endif
+
+        /**
+         * Check whether a timer has yet to fire (again)
+         *
+         * @param[in] t The timer
+         *
+         * @return True if \a t is pending
+         */
+        bool is_pending(const timer& t) const
+        {
+            const std::uint32_t index = find(t);
+            return index != nil && _nodes[index].list != unlinked;
+        }
+
+        /**
+         * @return The number of ticks elapsed
+         */
+        std::uint64_t now() const
+        {
+            return _now;
+        }
+
+        /**
+         * Fire a signal after a delay, and then (optionally) once every
+         * period. The signal is not copied, so it must outlive the timer
+         *
+         * @param[in] sig    The signal, which is raised with v_raise()
+         * @param[in] delay  How long until it first fires. This is
+         *                   rounded up to a whole number of ticks, and
+         *                   to at least one
+         * @param[in] period How often it fires after that, or zero to
+         *                   fire it once
+         *
+         * @return The timer, for cancelling it
+         */
+        timer schedule(generic* sig, clock::duration delay,
+                       clock::duration period = clock::duration::zero())
+        {
+            return add(sig, false, delay, period);
+        }
+
+        /**
+         * Fire a copy of a signal after a delay, and then (optionally)
+         * once every period. The copy is destroyed once the timer fires
+         * for the last time or is cancelled
+         *
+         * @param[in] sig    The signal to copy
+         * @param[in] delay  How long until it first fires. This is
+         *                   rounded up to a whole number of ticks, and
+         *                   to at least one
+         * @param[in] period How often it fires after that, or zero to
+         *                   fire it once
+         *
+         * @return The timer, for cancelling it
+         */
+        timer schedule(const generic& sig, clock::duration delay,
+                       clock::duration period = clock::duration::zero())
+        {
+            return add(sig.clone(), true, delay, period);
+        }
+
+        /**
+         * @return The number of pending timers
+         */
+        std::size_t size() const
+        {
+            return _size;
+        }
+
+        /**
+         * Advance by some number of ticks, firing every timer that comes
+         * due
+         *
+         * @param[in] count The number of ticks
+         *
+         * @return The number of timers fired
+         */
+        std::size_t tick(std::uint64_t count = 1)
+        {
+            std::size_t fired = 0;
+
+            for (; count > 0; count--)
+            {
+                if (_size == 0)
+                {
+                    _now += count;
+                    break;
+                }
+
+                _now++;
+
+                unsigned level = 0;
+                while (level + 1 < levels &&
+                       (_now & ((std::uint64_t(1) << (bits * (level + 1)))
+                                    - 1)) == 0)
+                {
+                    level++;
+                }
+
+                for (; level > 0; level--)
+                    cascade(level);
+
+                fired += expire();
+            }
+
+            return fired;
+        }
+
+        /**
+         * @return The length of a tick
+         */
+        clock::duration tick_length() const
+        {
+            return _tick;
+        }
+
+    private:
+
+        timer add(generic* sig, bool owned, clock::duration delay,
+                  clock::duration period)
+        {
+            std::uint32_t index = _free;
+
+            if (index != nil)
+                _free = _nodes[index].next;
+            else
+            {
+                index = static_cast<std::uint32_t>(_nodes.size());
+
+                node n = node();
+                n.generation = 1;
+                _nodes.push_back(n);
+            }
+
+            node& n = _nodes[index];
+            n.sig    = sig;
+            n.owned  = owned;
+            n.expiry = _now + ticks(delay);
+            n.period = period > clock::duration::zero() ? ticks(period) : 0;
+
+            link(index);
+
+            return timer((std::uint64_t(n.generation) << 32) | (index + 1));
+        }
+
+#if defined(__linux__)
+        /*
+         * Tick the timerfd only while timers are pending
+         */
+        void arm(bool on)
+        {
+            if (_fd == -1)
+                return;
+
+            const auto ns = std::chrono::duration_cast<
+                std::chrono::nanoseconds>(_tick).count();
+
+            itimerspec spec = {};
+            if (on)
+            {
+                spec.it_interval.tv_sec  = ns / 1000000000;
+                spec.it_interval.tv_nsec = ns % 1000000000;
+                spec.it_value = spec.it_interval;
+            }
+
+            ::timerfd_settime(_fd, 0, &spec, nullptr);
+        }
+#endif
+
+        /*
+         * Move every timer in the current slot of a level down to the
+         * levels below
+         */
+        void cascade(unsigned level)
+        {
+            const std::size_t list =
+                level * slots + ((_now >> (bits * level)) & mask);
+
+            std::uint32_t index = _heads[list];
+            _heads[list] = nil;
+
+            while (index != nil)
+            {
+                const std::uint32_t next = _nodes[index].next;
+
+                place(index);
+                index = next;
+            }
+        }
+
+        /*
+         * Fire the timers in the current slot of level 0
+         */
+        std::size_t expire()
+        {
+            const std::size_t list = _now & mask;
+            std::size_t fired = 0;
+
+            while (_heads[list] != nil)
+            {
+                const std::uint32_t index = _heads[list];
+
+                node& n = _nodes[index];
+                if (n.period)
+                {
+                    detach(index);
+
+                    n.expiry = _now + n.period;
+                    place(index);
+                }
+                else
+                    unlink(index);
+
+                firing_guard guard(*this, index);
+
+                n.sig->v_raise();
+                fired++;
+            }
+
+            return fired;
+        }
+
+        std::uint32_t find(const timer& t) const
+        {
+            const std::uint32_t index =
+                static_cast<std::uint32_t>(t.id()) - 1;
+
+            if (index >= _nodes.size() ||
+                _nodes[index].generation != (t.id() >> 32))
+            {
+                return nil;
+            }
+
+            return index;
+        }
+
+        /*
+         * Remove a timer from its list. The head of each list keeps the
+         * tail in its prev, so appending is O(1)
+         */
+        void detach(std::uint32_t index)
+        {
+            node& n = _nodes[index];
+            const std::size_t list = n.list;
+
+            if (_heads[list] == index)
+            {
+                _heads[list] = n.next;
+                if (n.next != nil)
+                    _nodes[n.next].prev = n.prev;
+            }
+            else
+            {
+                _nodes[n.prev].next = n.next;
+
+                if (n.next != nil)
+                    _nodes[n.next].prev = n.prev;
+                else
+                    _nodes[_heads[list]].prev = n.prev;
+            }
+
+            n.list = unlinked;
+        }
+
+        /*
+         * Add a timer to the pending ones
+         */
+        void link(std::uint32_t index)
+        {
+            place(index);
+
+#if defined(__linux__)
+            if (_size++ == 0)
+                arm(true);
+#else
+            _size++;
+#endif
+        }
+
+        /*
+         * Put a timer in the list for its expiry, relative to now
+         */
+        void place(std::uint32_t index)
+        {
+            node& n = _nodes[index];
+
+            std::uint64_t delta = n.expiry - _now;
+            if (delta > span)
+                delta = span;
+
+            const std::uint64_t at = _now + delta;
+
+            unsigned level = 0;
+            while (level + 1 < levels &&
+                   delta >= (std::uint64_t(1) << (bits * (level + 1))))
+            {
+                level++;
+            }
+
+            const std::size_t list =
+                level * slots + ((at >> (bits * level)) & mask);
+
+            /*
+             * Appended, so that timers due on the same tick fire in the
+             * order in which they were scheduled
+             */
+            n.list = static_cast<std::uint16_t>(list);
+            n.next = nil;
+
+            if (_heads[list] == nil)
+            {
+                n.prev = index;
+                _heads[list] = index;
+            }
+            else
+            {
+                node& head = _nodes[_heads[list]];
+
+                n.prev = head.prev;
+                _nodes[head.prev].next = index;
+                head.prev = index;
+            }
+        }
+
+        /*
+         * Return a timer's node to the free list, invalidating handles
+         * to it
+         */
+        void release(std::uint32_t index)
+        {
+            node& n = _nodes[index];
+
+            if (n.owned)
+                delete n.sig;
+
+            n.sig   = nullptr;
+            n.owned = false;
+            n.generation++;
+
+            n.next = _free;
+            _free  = index;
+        }
+
+        /*
+         * Convert a duration to ticks, rounding up to at least one
+         */
+        std::uint64_t ticks(clock::duration d) const
+        {
+            const std::uint64_t n = static_cast<std::uint64_t>(
+                (d + _tick - clock::duration(1)) / _tick);
+
+            return n > 0 ? n : 1;
+        }
+
+        /*
+         * Remove a timer from the pending ones
+         */
+        void unlink(std::uint32_t index)
+        {
+            detach(index);
+
+#if defined(__linux__)
+            if (--_size == 0)
+                arm(false);
+#else
+            _size--;
+#endif
+        }
+
+        int _fd;
+
+        std::uint32_t _firing;
+
+        std::uint32_t _free;
+
+        std::uint32_t _heads[levels * slots];
+
+        std::vector<node>
+            _nodes;
+
+        std::uint64_t _now;
+
+        std::size_t _size;
+
+        clock::time_point _start;
+
+        clock::duration _tick;
+    };
+}
+
+#endif // __TIMER_WHEEL_H__
@@ -0,0 +1,59 @@
+/**
+ *  \file   abort.h
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/signal
+ */
+
+#ifndef __ABORT_H__
+#define __ABORT_H__
+
+#include <cstdio>
+
+/**
+ * Return early from the enclosing function if a condition holds,
+ * reporting where to stderr
+ *
+ * @param[in] cond The condition to check
+ * @param[in] ret  The value to return. Leave this empty when the
+ *                 enclosing function returns void
+ * @param[in] ...  An optional printf-style message to report
+ */
+#define AbortIf(cond, ret, ...)                                     \
+    {                                                               \
+        if (cond)                                                   \
+        {                                                           \
+            std::fprintf(stderr, "[abort] %s:%d: %s\n",             \
+                         __FILE__, __LINE__, #cond);                \
+            abort_message(__VA_ARGS__);                             \
+            return ret;                                             \
+        }                                                           \
+    }
+
+/**
+ * Return early from the enclosing function unless a condition holds,
+ * reporting where to stderr
+ *
+ * @param[in] cond The condition to check
+ * @param[in] ret  The value to return. Leave this empty when the
+ *                 enclosing function returns void
+ * @param[in] ...  An optional printf-style message to report
+ */
+#define AbortIfNot(cond, ret, ...) \
+    AbortIf(!(cond), ret, __VA_ARGS__)
+
+#ifndef DOXYGEN_SKIP
+inline void abort_message()
+{
+}
+
+template <typename... T>
+inline void abort_message(const char* format, T... args)
+{
+    std::fprintf(stderr, "        ");
+    std::fprintf(stderr, format, args...);
+    std::fprintf(stderr, "\n");
+}
+#endif
+
+#endif // __ABORT_H__
@@ -0,0 +1,1240 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine)
+#include "Awaitable.h"
+#endif
+#include "CommandBuffer.h"
+#include "ConcurrentMulticast.h"
+#include "Delegate.h"
+#include "Multicast.h"
+#include "Pool.h"
+#include "Queued.h"
+#if defined(__linux__)
+#include "Reactor.h"
+#endif
+#include "Signal.h"
+#include "SignalRegistry.h"
+#include "TimerWheel.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Every allocation made through the global operator new is counted so
+ * that each benchmark can report allocations per iteration. Worker
+ * threads allocate too, so the count is atomic. The array and sized
+ * forms are replaced as well, so that each new is paired with a
+ * matching delete. None of them is inlined, since GCC would otherwise
+ * see malloc() and free() through them and report a mismatch
+ */
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+static std::atomic<std::size_t> allocations(0);
+
+BENCH_NOINLINE void* operator new(std::size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* ptr = std::malloc(size ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void* operator new[](std::size_t size)
+{
+	return ::operator new(size);
+}
+
+BENCH_NOINLINE void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+BENCH_NOINLINE void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+BENCH_NOINLINE void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+BENCH_NOINLINE void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+namespace bench
+{
+	volatile int sink = 0;
+
+	thread_local volatile int thread_sink = 0;
+
+	/*
+	 * Counts the user-space instructions retired by the main thread,
+	 * using perf_event_open on Linux. Elsewhere, or if the counter
+	 * cannot be opened (e.g. because of perf_event_paranoid), no
+	 * instruction counts are reported
+	 */
+	class instruction_counter
+	{
+
+	public:
+
+		instruction_counter() : _fd(-1)
+		{
+#if defined(__linux__)
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+
+			attr.type           = PERF_TYPE_HARDWARE;
+			attr.size           = sizeof(attr);
+			attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv     = 1;
+
+			_fd = static_cast<int>(
+				syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+		}
+
+		~instruction_counter()
+		{
+#if defined(__linux__)
+			if (_fd != -1)
+				close(_fd);
+#endif
+		}
+
+		bool is_open() const
+		{
+			return _fd != -1;
+		}
+
+		std::uint64_t read() const
+		{
+			std::uint64_t count = 0;
+#if defined(__linux__)
+			if (_fd != -1 && ::read(_fd, &count, sizeof(count)) !=
+				sizeof(count))
+			{
+				count = 0;
+			}
+#endif
+			return count;
+		}
+
+	private:
+
+		int _fd;
+	};
+
+	instruction_counter& instructions()
+	{
+		static instruction_counter counter;
+		return counter;
+	}
+
+	/*
+	 * Run f(i) for i in [0,n) and report the time, instructions and
+	 * number of heap allocations per iteration
+	 */
+	template <class F>
+	void run(const char* name, std::size_t n, F&& f)
+	{
+		typedef std::chrono::steady_clock clock;
+
+		const instruction_counter& counter = instructions();
+
+		const std::size_t start_allocs =
+			allocations.load(std::memory_order_relaxed);
+		const std::uint64_t start_instr = counter.read();
+		const auto start = clock::now();
+
+		for (std::size_t i = 0; i < n; i++)
+			f(i);
+
+		const auto stop = clock::now();
+		const std::uint64_t instr = counter.read() - start_instr;
+		const std::size_t allocs =
+			allocations.load(std::memory_order_relaxed) - start_allocs;
+
+		const double ns = std::chrono::duration<double, std::nano>(
+			stop - start).count();
+
+		if (counter.is_open())
+		{
+			std::printf("%-44s %10.2f ns/iter %8.2f instr/iter "
+				"%8.2f allocs/iter\n",
+				name, ns / n, double(instr) / n, double(allocs) / n);
+		}
+		else
+		{
+			std::printf("%-44s %10.2f ns/iter %8.2f allocs/iter\n",
+				name, ns / n, double(allocs) / n);
+		}
+
+		std::fflush(stdout);
+	}
+
+	/*
+	 * Run f(i) for i in [0,n) on each of several threads at once and
+	 * report the wall time per iteration per thread
+	 */
+	template <class F>
+	void run_threads(const char* name, std::size_t threads, std::size_t n,
+		F&& f)
+	{
+		typedef std::chrono::steady_clock clock;
+
+		std::vector<std::thread> pool;
+		const auto start = clock::now();
+
+		for (std::size_t t = 0; t < threads; t++)
+		{
+			pool.emplace_back([&]() {
+				for (std::size_t i = 0; i < n; i++)
+					f(i);
+			});
+		}
+
+		for (auto& thread : pool)
+			thread.join();
+
+		const auto stop = clock::now();
+
+		const double ns = std::chrono::duration<double, std::nano>(
+			stop - start).count();
+
+		std::printf("%-44s %10.2f ns/iter (%zu threads)\n",
+			name, ns / n, threads);
+		std::fflush(stdout);
+	}
+}
+
+namespace handlers
+{
+	std::atomic<long> queued_calls(0);
+
+	/*
+	 * Records the latency between raising a queued signal and its
+	 * handler running
+	 */
+	class LatencyHandler
+	{
+
+	public:
+
+		void handle(std::chrono::steady_clock::time_point raised)
+		{
+			last = std::chrono::steady_clock::now() - raised;
+			queued_calls.fetch_add(1);
+		}
+
+		std::chrono::steady_clock::duration last;
+	};
+
+	void queued(int a)
+	{
+		bench::thread_sink = bench::thread_sink + a;
+		queued_calls.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void func(int a)
+	{
+		bench::sink = bench::sink + a;
+	}
+
+	bool validate(int a)
+	{
+		bench::sink = bench::sink + a;
+		return a >= 0;
+	}
+
+	bool reject(int a)
+	{
+		bench::sink = bench::sink - a;
+		return false;
+	}
+
+	void text(std::string str)
+	{
+		bench::sink = bench::sink + int(str.size());
+	}
+
+	class Handler
+	{
+
+	public:
+
+		void method(int a)
+		{
+			bench::sink = bench::sink + a;
+		}
+
+		void const_method(int a) const
+		{
+			bench::sink = bench::sink - a;
+		}
+
+		void thread_method(int a) const
+		{
+			bench::thread_sink = bench::thread_sink + a;
+		}
+	};
+}
+
+/*
+ * Attaching and raising: the storage a Signal keeps for its handler
+ * lives inside the Signal, whereas the reference case puts the same
+ * handler behind a shared_ptr
+ */
+void attach_raise_cycle(std::size_t n)
+{
+	handlers::Handler obj;
+
+	Signal::Signal<void,int> sig;
+
+	bench::run("Signal::attach(fcn)+raise", n,
+		[&](std::size_t i) {
+			sig.attach(&handlers::func);
+			sig.raise(int(i));
+		});
+
+	bench::run("Signal::attach(obj,mem)+raise", n,
+		[&](std::size_t i) {
+			sig.attach(obj, &handlers::Handler::method);
+			sig.raise(int(i));
+		});
+
+	bench::run("Signal::attach(obj,const mem)+raise", n,
+		[&](std::size_t i) {
+			sig.attach(obj, &handlers::Handler::const_method);
+			sig.raise(int(i));
+		});
+
+	bench::run("Signal::attach(obj,mem)+copy+raise", n,
+		[&](std::size_t i) {
+			sig.attach(obj, &handlers::Handler::method);
+			Signal::Signal<void,int> copy(sig);
+			copy.raise(int(i));
+		});
+
+	std::shared_ptr<Signal::signal_t<void,int>> ref;
+
+	bench::run("shared_ptr<signal_t>::reset(mem)+raise", n,
+		[&](std::size_t i) {
+			ref.reset(new Signal::mem_ptr<void,handlers::Handler,int>(
+				obj, &handlers::Handler::method));
+			ref->raise(int(i));
+		});
+}
+
+/*
+ * Raising an attached handler: Signal dispatches through a thunk chosen
+ * at attach time, which is compared with the virtual signal_t::raise()
+ * that Signal previously went through (behind a shared_ptr)
+ */
+void raise_dispatch(std::size_t n)
+{
+	handlers::Handler obj;
+
+	Signal::Signal<void,int> sig_fcn(&handlers::func);
+	Signal::Signal<void,int> sig_mem(obj, &handlers::Handler::method);
+	Signal::Signal<void,int> sig_const(
+		obj, &handlers::Handler::const_method);
+
+	bench::run("Signal::raise(fcn)", n,
+		[&](std::size_t i) { sig_fcn.raise(int(i)); });
+	bench::run("Signal::raise(mem)", n,
+		[&](std::size_t i) { sig_mem.raise(int(i)); });
+	bench::run("Signal::raise(const mem)", n,
+		[&](std::size_t i) { sig_const.raise(int(i)); });
+
+	Signal::static_fcn<decltype(&handlers::func), &handlers::func>
+		static_fcn;
+	Signal::static_mem<decltype(&handlers::Handler::method),
+		&handlers::Handler::method> static_mem(obj);
+
+	bench::run("static_fcn::raise", n,
+		[&](std::size_t i) { static_fcn.raise(int(i)); });
+	bench::run("static_mem::raise", n,
+		[&](std::size_t i) { static_mem.raise(int(i)); });
+
+	std::shared_ptr<Signal::signal_t<void,int>> ref_fcn(
+		new Signal::fcn_ptr<void,int>(&handlers::func));
+	std::shared_ptr<Signal::signal_t<void,int>> ref_mem(
+		new Signal::mem_ptr<void,handlers::Handler,int>(
+			obj, &handlers::Handler::method));
+	std::shared_ptr<Signal::signal_t<void,int>> ref_const(
+		new Signal::mem_ptr<void,handlers::Handler,int>(
+			obj, &handlers::Handler::const_method));
+
+	bench::run("shared_ptr<signal_t>->raise(fcn)", n,
+		[&](std::size_t i) { ref_fcn->raise(int(i)); });
+	bench::run("shared_ptr<signal_t>->raise(mem)", n,
+		[&](std::size_t i) { ref_mem->raise(int(i)); });
+	bench::run("shared_ptr<signal_t>->raise(const mem)", n,
+		[&](std::size_t i) { ref_const->raise(int(i)); });
+}
+
+/*
+ * Fan-out to many subscribers: a Multicast versus looping over our own
+ * vector of Signals or std::functions
+ */
+void fan_out(std::size_t n)
+{
+	const std::size_t counts[] = { 1, 10, 100, 1000 };
+
+	for (std::size_t subscribers : counts)
+	{
+		std::vector<handlers::Handler> objs(subscribers);
+
+		Signal::Multicast<void,int> multicast;
+		std::vector<Signal::Signal<void,int>> signals;
+		std::vector<std::function<void(int)>> functions;
+
+		for (std::size_t i = 0; i < subscribers; i++)
+		{
+			multicast.connect(objs[i], &handlers::Handler::method);
+			signals.emplace_back(objs[i], &handlers::Handler::method);
+			functions.emplace_back(std::bind(&handlers::Handler::method,
+				&objs[i], std::placeholders::_1));
+		}
+
+		const std::size_t iters = n / subscribers;
+		char name[64];
+
+		std::snprintf(name, sizeof(name),
+			"Multicast::raise (%zu subscribers)", subscribers);
+		bench::run(name, iters,
+			[&](std::size_t i) { multicast.raise(int(i)); });
+
+		std::snprintf(name, sizeof(name),
+			"vector<Signal> loop (%zu subscribers)", subscribers);
+		bench::run(name, iters,
+			[&](std::size_t i) {
+				for (auto& sig : signals) sig.raise(int(i));
+			});
+
+		std::snprintf(name, sizeof(name),
+			"vector<std::function> loop (%zu subscribers)", subscribers);
+		bench::run(name, iters,
+			[&](std::size_t i) {
+				for (auto& func : functions) func(int(i));
+			});
+	}
+}
+
+/*
+ * Raising from several threads at once: a ConcurrentMulticast versus a
+ * Multicast guarded by a mutex
+ */
+void concurrent_raise(std::size_t n)
+{
+	const std::size_t subscribers = 10;
+	const std::size_t threads =
+		std::max(2u, std::thread::hardware_concurrency());
+
+	std::vector<handlers::Handler> objs(subscribers);
+
+	Signal::ConcurrentMulticast<void,int> concurrent;
+	Signal::Multicast<void,int> multicast;
+	std::mutex lock;
+
+	for (std::size_t i = 0; i < subscribers; i++)
+	{
+		concurrent.connect(objs[i], &handlers::Handler::thread_method);
+		multicast.connect(objs[i], &handlers::Handler::thread_method);
+	}
+
+	const std::size_t iters = n / subscribers / threads;
+
+	bench::run_threads("ConcurrentMulticast::raise (10 subscribers)",
+		threads, iters,
+		[&](std::size_t i) { concurrent.raise(int(i)); });
+
+	bench::run_threads("mutex + Multicast::raise (10 subscribers)",
+		threads, iters,
+		[&](std::size_t i) {
+			std::lock_guard<std::mutex> guard(lock);
+			multicast.raise(int(i));
+		});
+}
+
+/*
+ * Queued delivery: throughput of raising into a Dispatcher (including
+ * draining it) for each overflow policy, and the latency from raise()
+ * to the handler running on an otherwise idle pool
+ */
+void queued_delivery(std::size_t n)
+{
+	typedef std::chrono::steady_clock clock;
+
+	const struct {
+		const char* name;
+		Signal::overflow policy;
+	} policies[] = {
+		{ "block",       Signal::overflow::block },
+		{ "drop_newest", Signal::overflow::drop_newest },
+		{ "drop_oldest", Signal::overflow::drop_oldest }
+	};
+
+	for (std::size_t threads = 1; threads <= 2; threads++)
+	{
+		for (const auto& policy : policies)
+		{
+			Signal::Dispatcher pool(threads, 1024, policy.policy);
+			Signal::Queued<void,int> sig(pool);
+			sig.attach(&handlers::queued);
+
+			handlers::queued_calls.store(0);
+
+			const auto start = clock::now();
+
+			for (std::size_t i = 0; i < n; i++)
+				sig.raise(int(i));
+
+			pool.drain();
+
+			const double ns = std::chrono::duration<double, std::nano>(
+				clock::now() - start).count();
+
+			char name[64];
+			std::snprintf(name, sizeof(name),
+				"Queued::raise+drain (%s, %zu workers)", policy.name,
+				threads);
+
+			std::printf("%-44s %10.2f ns/iter %8.2f%% dropped\n",
+				name, ns / n, 100.0 * pool.dropped() / n);
+		}
+	}
+
+	Signal::Dispatcher pool(1, 1024);
+	handlers::LatencyHandler handler;
+
+	Signal::Queued<void,clock::time_point> sig(pool);
+	sig.attach(handler, &handlers::LatencyHandler::handle);
+
+	std::vector<double> samples;
+	for (std::size_t i = 0; i < 10000; i++)
+	{
+		const long calls = handlers::queued_calls.load();
+
+		sig.raise(clock::now());
+
+		while (handlers::queued_calls.load() == calls)
+			std::this_thread::yield();
+
+		samples.push_back(std::chrono::duration<double, std::nano>(
+			handler.last).count());
+	}
+
+	std::sort(samples.begin(), samples.end());
+
+	std::printf("%-44s %10.2f ns p50 %10.2f ns p99\n",
+		"Queued::raise latency (idle pool)",
+		samples[samples.size() / 2], samples[samples.size() * 99 / 100]);
+	std::fflush(stdout);
+}
+
+/*
+ * Raising over a batch of queued events: a loop of raise() calls versus
+ * a single raise_batch()
+ */
+void batch_raise(std::size_t n)
+{
+	const std::size_t batch = 1024;
+	handlers::Handler obj;
+
+	std::vector<std::tuple<int>> args;
+	std::vector<int> column;
+	for (std::size_t i = 0; i < batch; i++)
+	{
+		args.push_back(std::make_tuple(int(i)));
+		column.push_back(int(i));
+	}
+
+	Signal::Signal<void,int> sig(obj, &handlers::Handler::method);
+	Signal::mem_ptr<void,handlers::Handler,int> mem(obj,
+		&handlers::Handler::method);
+
+	const std::size_t iters = n / batch;
+
+	bench::run("Signal::raise loop (1024 events)", iters,
+		[&](std::size_t) {
+			for (std::size_t i = 0; i < batch; i++)
+				sig.raise(std::get<0>(args[i]));
+		});
+	bench::run("Signal::raise_batch(tuples) (1024 events)", iters,
+		[&](std::size_t) { sig.raise_batch(args.data(), batch); });
+	bench::run("Signal::raise_batch(columns) (1024 events)", iters,
+		[&](std::size_t) {
+			sig.raise_batch(Signal::columns(column.data()), batch);
+		});
+
+	bench::run("mem_ptr::raise loop (1024 events)", iters,
+		[&](std::size_t) {
+			for (std::size_t i = 0; i < batch; i++)
+				mem.raise(std::get<0>(args[i]));
+		});
+	bench::run("mem_ptr::raise_batch(tuples) (1024 events)", iters,
+		[&](std::size_t) { mem.raise_batch(args.data(), batch); });
+}
+
+/*
+ * Cloning a registry of 1024 signals and tearing it down again: each
+ * clone from the heap versus from a pool that is reset in bulk
+ */
+void pool_clone(std::size_t n)
+{
+	const std::size_t count = 1024;
+	handlers::Handler obj;
+
+	Signal::Signal<void,int> sig(obj, &handlers::Handler::method);
+	std::vector<Signal::generic*> clones(count);
+
+	Signal::pool mem(sizeof(sig), count);
+
+	const std::size_t iters = n / count;
+
+	bench::run("clone() + delete (1024 signals)", iters,
+		[&](std::size_t) {
+			for (std::size_t i = 0; i < count; i++)
+				clones[i] = sig.clone();
+			for (std::size_t i = 0; i < count; i++)
+				delete clones[i];
+		});
+	bench::run("clone(pool) + reset (1024 signals)", iters,
+		[&](std::size_t) {
+			for (std::size_t i = 0; i < count; i++)
+				clones[i] = sig.clone(mem);
+			for (std::size_t i = 0; i < count; i++)
+				clones[i]->~generic();
+			mem.reset();
+		});
+}
+
+/*
+ * Raising a collection of 1024 mixed signals through generic: a
+ * SignalRegistry versus a vector of individually allocated clones
+ */
+void registry_raise(std::size_t n)
+{
+	const std::size_t count = 1024;
+	handlers::Handler obj;
+
+	Signal::Signal<void,int> sig(obj, &handlers::Handler::method);
+	Signal::fcn_ptr<void,int> fcn(&handlers::func);
+	sig.bind(1); fcn.bind(2);
+
+	Signal::SignalRegistry registry;
+	std::vector<std::unique_ptr<Signal::generic>> signals;
+
+	for (std::size_t i = 0; i < count; i++)
+	{
+		const Signal::generic& next = i % 2 ?
+			static_cast<const Signal::generic&>(fcn) : sig;
+
+		registry.add(next);
+		signals.emplace_back(next.clone());
+	}
+
+	const std::size_t iters = n / count;
+
+	bench::run("SignalRegistry::raise_all (1024 signals)", iters,
+		[&](std::size_t) { registry.raise_all(); });
+	bench::run("vector<unique_ptr<generic>> (1024 signals)", iters,
+		[&](std::size_t) {
+			for (std::size_t i = 0; i < count; i++)
+				signals[i]->v_raise();
+		});
+
+	bench::run("SignalRegistry::raise(id)", n,
+		[&](std::size_t i) { registry.raise(i % count); });
+	bench::run("vector<unique_ptr<generic>>[id]->v_raise", n,
+		[&](std::size_t i) { signals[i % count]->v_raise(); });
+}
+
+/*
+ * Recording 1024 deferred calls and replaying them: a CommandBuffer
+ * versus binding arguments to a clone of a signal per call
+ */
+void deferred_calls(std::size_t n)
+{
+	const std::size_t count = 1024;
+	handlers::Handler obj;
+
+	Signal::fcn_ptr<void,int> fcn(&handlers::func);
+	std::vector<std::unique_ptr<Signal::generic>> signals;
+	signals.reserve(count);
+
+	Signal::CommandBuffer buffer(count * 64);
+
+	const std::size_t iters = n / count;
+
+	bench::run("clone + bind + v_raise (1024 calls)", iters,
+		[&](std::size_t) {
+			for (std::size_t i = 0; i < count; i++)
+			{
+				auto sig = static_cast<Signal::fcn_ptr<void,int>*>(
+					fcn.clone());
+				sig->bind(int(i));
+				signals.emplace_back(sig);
+			}
+			for (std::size_t i = 0; i < count; i++)
+				signals[i]->v_raise();
+			signals.clear();
+		});
+	bench::run("CommandBuffer record + replay (1024 calls)", iters,
+		[&](std::size_t) {
+			for (std::size_t i = 0; i < count; i++)
+			{
+				if (i % 2)
+					buffer.record(&handlers::func, int(i));
+				else
+					buffer.record(obj, &handlers::Handler::method,
+						int(i));
+			}
+			buffer.replay();
+			buffer.clear();
+		});
+}
+
+/*
+ * Growing a vector of 1024 Signals with bound arguments one push_back
+ * at a time. Signals relocate by moving, so the bound strings are
+ * never copied; a shared handler is not even moved
+ */
+void vector_growth(std::size_t n)
+{
+	const std::size_t count = 1024;
+
+	Signal::Signal<void,std::string> sig(&handlers::text);
+	sig.bind(std::string(64, 'x'));
+
+	Signal::Signal<void,std::string> shared(sig);
+	shared.set_policy(Signal::copy_policy::share);
+
+	const std::size_t iters = n / count / 10;
+
+	bench::run("vector<Signal> growth (1024 deep copies)", iters,
+		[&](std::size_t) {
+			std::vector<Signal::Signal<void,std::string>> signals;
+			for (std::size_t i = 0; i < count; i++)
+				signals.push_back(sig);
+		});
+	bench::run("vector<Signal> growth (1024 shared copies)", iters,
+		[&](std::size_t) {
+			std::vector<Signal::Signal<void,std::string>> signals;
+			for (std::size_t i = 0; i < count; i++)
+				signals.push_back(shared);
+		});
+}
+
+/*
+ * A table of 64K callbacks: building it one push_back at a time and
+ * raising every entry, as Delegates versus Signals
+ */
+void handler_table(std::size_t n)
+{
+	const std::size_t count = 65536;
+	handlers::Handler obj;
+
+	typedef Signal::Delegate<void,int> delegate;
+
+	const std::size_t iters = n / count;
+
+	std::vector<delegate> delegates;
+	std::vector<Signal::Signal<void,int>> signals;
+
+	bench::run("vector<Delegate> growth (64K entries)", iters,
+		[&](std::size_t) {
+			std::vector<delegate> table;
+			for (std::size_t i = 0; i < count; i++)
+			{
+				table.push_back(delegate::from<handlers::Handler,
+					&handlers::Handler::method>(obj));
+			}
+			delegates.swap(table);
+		});
+	bench::run("vector<Signal> growth (64K entries)", iters,
+		[&](std::size_t) {
+			std::vector<Signal::Signal<void,int>> table;
+			for (std::size_t i = 0; i < count; i++)
+				table.emplace_back(obj, &handlers::Handler::method);
+			signals.swap(table);
+		});
+
+	bench::run("vector<Delegate> raise all (64K entries)", iters,
+		[&](std::size_t) {
+			for (std::size_t i = 0; i < count; i++)
+				delegates[i].raise(int(i));
+		});
+	bench::run("vector<Signal> raise all (64K entries)", iters,
+		[&](std::size_t) {
+			for (std::size_t i = 0; i < count; i++)
+				signals[i].raise(int(i));
+		});
+}
+
+/*
+ * A validation chain of 10 handlers with priorities, where the third
+ * one rejects: stopping early with a first_false combiner versus
+ * invoking every handler
+ */
+void validation_chain(std::size_t n)
+{
+	Signal::Multicast<bool,int> chain;
+
+	for (int i = 0; i < 10; i++)
+	{
+		chain.connect(10 - i, i == 2 ?
+			&handlers::reject : &handlers::validate);
+	}
+
+	bench::run("Multicast::raise (10 validators)", n,
+		[&](std::size_t i) { chain.raise(int(i)); });
+	bench::run("Multicast::raise_with(first_false)", n,
+		[&](std::size_t i) {
+			Signal::first_false combiner;
+			bench::sink = bench::sink +
+				chain.raise_with(combiner, int(i));
+		});
+	bench::run("Multicast::raise_with(sum)", n,
+		[&](std::size_t i) {
+			Signal::sum<int> combiner;
+			bench::sink = bench::sink +
+				chain.raise_with(combiner, int(i));
+		});
+}
+
+/*
+ * Every way of invoking a handler through Signal.h, next to a raw
+ * function pointer, a std::function and a lambda the compiler can see
+ * through. The loop itself costs what the lambda row costs
+ */
+void dispatch_paths(std::size_t n)
+{
+	handlers::Handler obj;
+
+	void (*volatile raw)(int) = &handlers::func;
+	std::function<void(int)> function(&handlers::func);
+	auto lambda = [](int a) { bench::sink = bench::sink + a; };
+
+	bench::run("lambda (inlined)", n,
+		[&](std::size_t i) { lambda(int(i)); });
+	bench::run("raw function pointer", n,
+		[&](std::size_t i) { raw(int(i)); });
+	bench::run("std::function", n,
+		[&](std::size_t i) { function(int(i)); });
+
+	Signal::fcn_ptr<void,int> fcn(&handlers::func);
+	Signal::mem_ptr<void,handlers::Handler,int> mem(
+		obj, &handlers::Handler::method);
+	Signal::mem_ptr<void,handlers::Handler,int> mem_const(
+		obj, &handlers::Handler::const_method);
+
+	bench::run("fcn_ptr::raise", n,
+		[&](std::size_t i) { fcn.raise(int(i)); });
+	bench::run("mem_ptr::raise", n,
+		[&](std::size_t i) { mem.raise(int(i)); });
+	bench::run("mem_ptr::raise (const)", n,
+		[&](std::size_t i) { mem_const.raise(int(i)); });
+
+	Signal::Signal<void,int> sig(obj, &handlers::Handler::method);
+
+	bench::run("Signal::raise(args)", n,
+		[&](std::size_t i) { sig.raise(int(i)); });
+
+	Signal::Signal<void,int> bound(obj, &handlers::Handler::method);
+	bound.bind(1);
+
+	bench::run("Signal::raise() (bound)", n,
+		[&](std::size_t) { bound.raise(); });
+
+	int arg = 0;
+	Signal::Signal<void,int> forwarded(obj, &handlers::Handler::method);
+	forwarded.forward(arg);
+
+	bench::run("Signal::raise() (forwarded)", n,
+		[&](std::size_t i) { arg = int(i); forwarded.raise(); });
+
+	/*
+	 * Read through a volatile so the call cannot be devirtualized
+	 */
+	Signal::generic* volatile gen = &bound;
+
+	bench::run("generic*->v_raise()", n,
+		[&](std::size_t) { gen->v_raise(); });
+
+	Signal::Callable<decltype(lambda)> callable(lambda);
+	Signal::Callable<void(*)(int)> callable_fcn(&handlers::func);
+
+	bench::run("Callable::raise (lambda)", n,
+		[&](std::size_t i) { callable.raise(int(i)); });
+	bench::run("Callable::raise (function pointer)", n,
+		[&](std::size_t i) { callable_fcn.raise(int(i)); });
+}
+
+/*
+ * Connecting and disconnecting one handler while 1000 others stay
+ * connected, directly and through a scoped_connection
+ */
+void connect_disconnect(std::size_t n)
+{
+	std::vector<handlers::Handler> objs(1000);
+	Signal::Multicast<void,int> multicast;
+
+	for (auto& obj : objs)
+		multicast.connect(obj, &handlers::Handler::method);
+
+	handlers::Handler extra;
+
+	bench::run("Multicast::connect+disconnect (1000 others)", n,
+		[&](std::size_t) {
+			multicast.disconnect(
+				multicast.connect(extra, &handlers::Handler::method));
+		});
+	bench::run("scoped_connection (1000 others)", n,
+		[&](std::size_t) {
+			Signal::scoped_connection conn(multicast,
+				multicast.connect(extra, &handlers::Handler::method));
+		});
+}
+
+/*
+ * Lambdas as handlers. A Signal keeps captures of up to
+ * SIGNAL_CALLABLE_CAPACITY bytes in its own storage, whereas
+ * std::function allocates once they outgrow its (smaller) buffer.
+ * Callable is not type-erased, so it is a lower bound
+ */
+void callable_handlers(std::size_t n)
+{
+	handlers::Handler obj;
+	const long scale = 3, shift = 4;
+	const long table[6] = { scale, shift };
+
+	auto small = [&obj](int a) { obj.method(a); };
+	auto large = [&obj, scale, shift](int a) {
+		obj.method(int(a * scale + shift)); };
+	auto huge  = [&obj, table](int a) {
+		obj.method(int(a * table[0] + table[1])); };
+
+	Signal::Signal<void,int> sig(large);
+	std::function<void(int)> func(large);
+	Signal::Callable<decltype(large)> callable(large);
+
+	bench::run("Signal::raise (24-byte lambda)", n,
+		[&](std::size_t i) { sig.raise(int(i)); });
+	bench::run("std::function (24-byte lambda)", n,
+		[&](std::size_t i) { func(int(i)); });
+	bench::run("Callable::raise (24-byte lambda)", n,
+		[&](std::size_t i) { callable.raise(int(i)); });
+
+	bench::run("Signal::attach(8-byte lambda)+raise", n,
+		[&](std::size_t i) {
+			sig.attach(small);
+			sig.raise(int(i));
+		});
+	bench::run("std::function=(8-byte lambda)+call", n,
+		[&](std::size_t i) {
+			func = small;
+			func(int(i));
+		});
+
+	bench::run("Signal::attach(24-byte lambda)+raise", n,
+		[&](std::size_t i) {
+			sig.attach(large);
+			sig.raise(int(i));
+		});
+	bench::run("std::function=(24-byte lambda)+call", n,
+		[&](std::size_t i) {
+			func = large;
+			func(int(i));
+		});
+
+	bench::run("Signal::attach(24-byte lambda)+copy+raise", n,
+		[&](std::size_t i) {
+			sig.attach(large);
+			Signal::Signal<void,int> copy(sig);
+			copy.raise(int(i));
+		});
+	bench::run("std::function=(24-byte lambda)+copy+call", n,
+		[&](std::size_t i) {
+			func = large;
+			std::function<void(int)> copy(func);
+			copy(int(i));
+		});
+
+	bench::run("Signal::attach(56-byte lambda, heap)+raise", n,
+		[&](std::size_t i) {
+			sig.attach(huge);
+			sig.raise(int(i));
+		});
+}
+
+/*
+ * Inserting, cancelling and firing a large number of timers, each with
+ * a pseudo-random delay of up to ~4 minutes at 1 ms ticks (so that most
+ * of them start in an upper level of the wheel). Firing is reported per
+ * timer, including the ticks that fire nothing. The reference case is a
+ * binary heap of deadlines, which has no cheap cancel
+ */
+void timer_wheel(std::size_t timers)
+{
+	typedef std::chrono::milliseconds ms;
+
+	std::size_t fired = 0;
+	Signal::Signal<void> sig([&fired]() { fired++; });
+
+	std::vector<std::uint32_t> delays(timers);
+	std::uint32_t seed = 12345;
+	for (std::size_t i = 0; i < timers; i++)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		delays[i] = 1 + (seed >> 8) % (1u << 18);
+	}
+
+	Signal::TimerWheel wheel(ms(1));
+	std::vector<Signal::timer> handles(timers);
+
+	bench::run("TimerWheel::schedule (1M timers)", timers,
+		[&](std::size_t i) {
+			handles[i] = wheel.schedule(&sig, ms(delays[i]));
+		});
+	bench::run("TimerWheel::cancel (1M timers)", timers,
+		[&](std::size_t i) {
+			bench::sink = bench::sink + wheel.cancel(handles[i]);
+		});
+
+	for (std::size_t i = 0; i < timers; i++)
+		wheel.schedule(&sig, ms(delays[i]));
+
+	bench::run("TimerWheel::tick (1M timers, per fire)", timers,
+		[&](std::size_t i) {
+			while (fired <= i)
+				wheel.tick();
+		});
+
+	typedef std::pair<std::uint64_t, Signal::generic*> deadline;
+
+	std::vector<deadline> storage;
+	storage.reserve(timers);
+
+	std::priority_queue<deadline, std::vector<deadline>,
+		std::greater<deadline>> heap(std::greater<deadline>(),
+			std::move(storage));
+
+	bench::run("std::priority_queue::push (1M timers)", timers,
+		[&](std::size_t i) {
+			heap.push(deadline(delays[i], &sig));
+		});
+
+	std::uint64_t now = 0; fired = 0;
+
+	bench::run("std::priority_queue::pop (1M timers, per fire)", timers,
+		[&](std::size_t i) {
+			while (fired <= i)
+			{
+				for (now++; !heap.empty() && heap.top().first <= now; )
+				{
+					heap.top().second->v_raise();
+					heap.pop();
+				}
+			}
+		});
+}
+
+#if defined(__linux__)
+/*
+ * Throughput of a Reactor over a set of pipes: each round writes a byte
+ * to every pipe, then polls until every handler has read its byte. The
+ * reference case is a hand-written epoll loop that reads directly
+ */
+void reactor_throughput(std::size_t rounds)
+{
+	const std::size_t pipes = 64;
+	const char byte = 'x';
+
+	std::vector<int> fds(2 * pipes);
+	for (std::size_t i = 0; i < pipes; i++)
+	{
+		if (::pipe(&fds[2 * i]) != 0)
+			return;
+	}
+
+	auto write_all = [&]() {
+		for (std::size_t i = 0; i < pipes; i++)
+			bench::sink = bench::sink +
+				int(::write(fds[2 * i + 1], &byte, 1));
+	};
+
+	std::size_t handled = 0;
+
+	auto drain = [&handled](int fd) {
+		char c;
+		bench::sink = bench::sink + int(::read(fd, &c, 1));
+		handled++;
+	};
+
+	const Signal::reactor_backend backends[] = {
+		Signal::reactor_backend::epoll,
+		Signal::reactor_backend::io_uring
+	};
+
+	for (Signal::reactor_backend backend : backends)
+	{
+		Signal::Reactor reactor(backend, pipes);
+		if (reactor.backend() != backend)
+			continue;
+
+		for (std::size_t i = 0; i < pipes; i++)
+			reactor.add(fds[2 * i], drain);
+
+		bench::run(backend == Signal::reactor_backend::epoll ?
+			"Reactor::poll (epoll, 64 pipes/round)" :
+			"Reactor::poll (io_uring, 64 pipes/round)", rounds,
+			[&](std::size_t) {
+				write_all();
+				for (handled = 0; handled < pipes; )
+					reactor.poll(-1);
+			});
+	}
+
+	const int epfd = ::epoll_create1(0);
+	for (std::size_t i = 0; i < pipes; i++)
+	{
+		epoll_event event;
+		event.events  = EPOLLIN;
+		event.data.fd = fds[2 * i];
+		::epoll_ctl(epfd, EPOLL_CTL_ADD, fds[2 * i], &event);
+	}
+
+	std::vector<epoll_event> events(pipes);
+
+	bench::run("epoll_wait loop (64 pipes/round)", rounds,
+		[&](std::size_t) {
+			write_all();
+			for (handled = 0; handled < pipes; )
+			{
+				const int n = ::epoll_wait(epfd, events.data(),
+					int(events.size()), -1);
+				for (int i = 0; i < n; i++)
+					drain(events[i].data.fd);
+			}
+		});
+
+	::close(epfd);
+	for (std::size_t i = 0; i < fds.size(); i++)
+		::close(fds[i]);
+}
+#endif
+
+#if defined(__cpp_impl_coroutine)
+/*
+ * Resuming coroutines that wait on an Awaitable, against invoking the
+ * same work as an ordinary handler. Each waiting coroutine loops over
+ * co_await, so an iteration includes it waiting again
+ */
+void coroutine_resume(std::size_t n)
+{
+	Signal::Signal<void,int> callback(
+		[](int a) { bench::sink = bench::sink + a; });
+
+	bench::run("Signal::raise (callback)", n,
+		[&](std::size_t i) { callback.raise(int(i)); });
+
+	Signal::Awaitable<void,int> with_handler(
+		[](int a) { bench::sink = bench::sink + a; });
+
+	bench::run("Awaitable::raise (callback, no waiters)", n,
+		[&](std::size_t i) { with_handler.raise(int(i)); });
+
+	Signal::Awaitable<void,int> sig;
+
+	auto listen = [&sig](std::size_t times) -> Signal::async_handler {
+		for (std::size_t i = 0; i < times; i++)
+		{
+			auto [a] = co_await sig;
+			bench::sink = bench::sink + a;
+		}
+	};
+
+	listen(n);
+
+	bench::run("Awaitable::raise (resume 1 coroutine)", n,
+		[&](std::size_t i) { sig.raise(int(i)); });
+
+	const std::size_t fan = 16;
+
+	Signal::Multicast<void,int> multicast;
+	for (std::size_t i = 0; i < fan; i++)
+		multicast.connect(&handlers::func);
+
+	bench::run("Multicast::raise (16 handlers)", n / fan,
+		[&](std::size_t i) { multicast.raise(int(i)); });
+
+	for (std::size_t i = 0; i < fan; i++)
+		listen(n / fan);
+
+	bench::run("Awaitable::raise (resume 16 coroutines)", n / fan,
+		[&](std::size_t i) { sig.raise(int(i)); });
+}
+#endif
+
+int main()
+{
+	const std::size_t n = 10000000;
+
+	dispatch_paths(n);
+
+	attach_raise_cycle(n);
+	raise_dispatch(n);
+	fan_out(n);
+	concurrent_raise(n);
+	queued_delivery(n / 10);
+	batch_raise(n);
+	pool_clone(n);
+	registry_raise(n);
+	deferred_calls(n);
+	vector_growth(n);
+	handler_table(n);
+	validation_chain(n);
+	connect_disconnect(n);
+	callable_handlers(n);
+#if defined(__linux__)
+	reactor_throughput(n / 1000);
+#endif
+	timer_wheel(n / 10);
+#if defined(__cpp_impl_coroutine)
+	coroutine_resume(n);
+#endif
+
+	return 0;
+}
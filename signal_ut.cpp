@@ -1,8 +1,39 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <unistd.h>
+#endif
 
 #include "abort.h"
+#if defined(__cpp_impl_coroutine)
+#include "Awaitable.h"
+#endif
+#include "CommandBuffer.h"
+#include "ConcurrentMulticast.h"
+#include "Delegate.h"
+#include "Instrument.h"
+#include "Multicast.h"
+#include "Pool.h"
+#include "Queued.h"
+#if defined(__linux__)
+#include "Reactor.h"
+#endif
 #include "Signal.h"
+#include "SignalRegistry.h"
+#include "TimerWheel.h"
 
 namespace test_funcs
 {
@@ -391,174 +422,2713 @@ public:
 	}
 };
 
-namespace net
+namespace multicast_funcs
 {
-	class DataBuffer
+	int total = 0;
+
+	void add(int a)
 	{
+		total += a;
+	}
+}
 
-	public:
+class counter
+{
 
-		DataBuffer() : _buf(nullptr), _size(0)
-		{
-		}
+public:
 
-		DataBuffer(char* buf, size_t size)
-			: _buf(buf), _size(size)
+	counter() : calls(0), total(0)
+	{
+	}
+
+	void add(int a)
+	{
+		calls++; total += a;
+	}
+
+	int get(int a) const
+	{
+		return total + a;
+	}
+
+	int calls;
+	int total;
+};
+
+class multicast_test
+{
+
+public:
+
+	bool run()
+	{
+		counter c1, c2;
+		const counter c3;
+
+		Signal::Multicast<void,int> sig;
+		AbortIf(sig.is_connected(), false);
+
+		Signal::connection conn1 = sig.connect(&multicast_funcs::add);
+		Signal::connection conn2 = sig.connect(c1, &counter::add);
+		Signal::connection conn3 = sig.connect(c2, &counter::add);
+
+		AbortIfNot(conn1.is_valid(), false);
+		AbortIf(conn1 == conn2 || conn2 == conn3, false);
+		AbortIfNot(sig.size() == 3, false);
+
+		sig.raise(5);
+
+		AbortIfNot(multicast_funcs::total == 5, false);
+		AbortIfNot(c1.calls == 1 && c1.total == 5, false);
+		AbortIfNot(c2.calls == 1 && c2.total == 5, false);
+
+		AbortIfNot(sig.disconnect(conn2), false);
+		AbortIf(sig.disconnect(conn2), false);
+		AbortIf(sig.is_connected(conn2), false);
+		AbortIfNot(sig.is_connected(conn3), false);
+
+		sig.bind(2);
+		Signal::generic* gen_sig = &sig;
+		gen_sig->v_raise();
+
+		AbortIfNot(multicast_funcs::total == 7, false);
+		AbortIfNot(c1.calls == 1, false);
+		AbortIfNot(c2.calls == 2 && c2.total == 7, false);
+
+		int x = 10;
+		sig.forward(x);
+		sig.raise();
+		AbortIfNot(c2.total == 17, false);
+
+		Signal::Multicast<int,int> sig2;
+		AbortIfNot(sig2.connect(c3, &counter::get).is_valid(), false);
+		AbortIf(sig2.connect(static_cast<int(*)(int)>(nullptr)).is_valid(),
+			false);
+		sig2.raise(1);
+
+		sig.disconnect_all();
+		AbortIf(sig.is_connected(), false);
+		AbortIf(sig.is_connected(conn1), false);
+
+		return true;
+	}
+};
+
+class atomic_counter
+{
+
+public:
+
+	atomic_counter() : calls(0)
+	{
+	}
+
+	void hit(int)
+	{
+		calls.fetch_add(1);
+	}
+
+	std::atomic<long> calls;
+};
+
+class concurrent_multicast_test
+{
+
+public:
+
+	bool run()
+	{
+		const int raisers = 4;
+		const int raises  = 20000;
+
+		atomic_counter permanent;
+		std::vector<atomic_counter> churned(16);
+
+		Signal::ConcurrentMulticast<void,int> sig;
+		AbortIf(sig.is_connected(), false);
+
+		Signal::connection conn = sig.connect(permanent,
+			&atomic_counter::hit);
+		AbortIfNot(conn.is_valid(), false);
+
+		std::atomic<int> done(0);
+		std::vector<std::thread> threads;
+
+		for (int i = 0; i < raisers; i++)
 		{
+			threads.emplace_back([&]() {
+				for (int j = 0; j < raises; j++)
+					sig.raise(j);
+				done.fetch_add(1);
+			});
 		}
 
-		~DataBuffer()
+		/*
+		 * Churn the subscriber set until all raisers are finished:
+		 */
+		std::vector<Signal::connection> conns;
+		for (int n = 0; n < 100 || done.load() < raisers; n++)
 		{
+			for (auto& counter : churned)
+				conns.push_back(sig.connect(counter,
+					&atomic_counter::hit));
+
+			for (auto& c : conns)
+				AbortIfNot(sig.disconnect(c), false);
+
+			conns.clear();
 		}
 
-		size_t size() { return _size; }
+		for (auto& thread : threads)
+			thread.join();
 
-	private:
+		sig.synchronize();
 
-		char* _buf; size_t _size;
-	};
-}
+		AbortIfNot(permanent.calls.load() == long(raisers) * raises,
+			false);
+		AbortIfNot(sig.size() == 1, false);
+		AbortIfNot(sig.is_connected(conn), false);
 
-char* raw = new char[1024];
+		Signal::ConcurrentMulticast<void,int> other;
+		Signal::connection foreign = other.connect(permanent,
+			&atomic_counter::hit);
+		AbortIf(sig.is_connected(foreign), false);
+		AbortIf(other.disconnect(conn), false);
 
-class Test
+		AbortIfNot(sig.disconnect(conn), false);
+		AbortIf(sig.is_connected(), false);
+
+		return true;
+	}
+};
+
+class queued_handler
 {
 
 public:
 
-	void func(net::DataBuffer& buf)
+	queued_handler() : calls(0), hold(false), started(false), total(0)
 	{
-		buf = net::DataBuffer(raw, 512);
 	}
 
-	void func2(net::DataBuffer buf)
+	void handle(int a, const std::string& s)
 	{
-		std::printf("%s: buffer is %zu bytes.\n",
-				__FUNCTION__, buf.size());
-		std::fflush(stdout);
+		started.store(true);
+
+		while (hold.load())
+			std::this_thread::yield();
+
+		calls.fetch_add(1);
+		total.fetch_add(a + long(s.size()));
 	}
+
+	std::atomic<long> calls;
+	std::atomic<bool> hold;
+	std::atomic<bool> started;
+	std::atomic<long> total;
 };
 
-void func(net::DataBuffer& buf)
+class queued_test
 {
-	net::DataBuffer b2(raw, 1024);
-	buf = b2;
-}
 
-bool test_fcn_ptr()
-{
-	Signal::fcn_ptr<void,net::DataBuffer&>
-		sig;
-	AbortIfNot(sig.attach(&func), false);
+public:
 
-	net::DataBuffer buf;
-	sig.forward(buf);
+	static_assert(
+		std::is_nothrow_move_constructible<Signal::task>::value &&
+		std::is_nothrow_move_assignable<Signal::task>::value,
+		"Containers of pending tasks should move them on growth");
 
-	sig.raise();
+	bool run()
+	{
+		AbortIfNot(run_block(), false);
+		AbortIfNot(run_drop(Signal::overflow::drop_newest), false);
+		AbortIfNot(run_drop(Signal::overflow::drop_oldest), false);
 
-	std::printf("%s: buffer is %zu bytes.\n",
-				__FUNCTION__, buf.size());
-	std::fflush(stdout);
+		return true;
+	}
 
-	return true;
-}
+private:
 
-bool test_mem_ptr()
-{
-	Test test;
-	Signal::mem_ptr<void,Test,net::DataBuffer&>
-		sig(test);
+	bool run_block()
+	{
+		queued_handler handler;
 
-	AbortIfNot(sig.attach(&Test::func), false);
+		Signal::Dispatcher pool(2, 8, Signal::overflow::block);
+		Signal::Queued<void,int,const std::string&> sig(pool);
 
-	net::DataBuffer buf;
-	sig.forward(buf);
+		AbortIfNot(sig.attach(handler, &queued_handler::handle), false);
 
-	sig.raise();
+		for (int i = 0; i < 1000; i++)
+			AbortIfNot(sig.raise(i, "abc"), false);
 
-	std::printf("%s: buffer is %zu bytes.\n",
-				__FUNCTION__, buf.size());
-	std::fflush(stdout);
+		pool.drain();
 
-	return true;
+		AbortIfNot(handler.calls.load() == 1000, false);
+		AbortIfNot(handler.total.load() == 999 * 1000 / 2 + 3000,
+			false);
+		AbortIfNot(pool.dropped() == 0, false);
+
+		return true;
+	}
+
+	/*
+	 * Fill the queue of a single worker while it is blocked in the
+	 * handler, then overflow it by one
+	 */
+	bool run_drop(Signal::overflow policy)
+	{
+		queued_handler handler;
+		handler.hold.store(true);
+
+		Signal::Dispatcher pool(1, 4, policy);
+		Signal::Queued<void,int,const std::string&> sig(pool);
+
+		AbortIfNot(sig.attach(handler, &queued_handler::handle), false);
+
+		AbortIfNot(sig.raise(1000, ""), false);
+		while (!handler.started.load())
+			std::this_thread::yield();
+
+		for (int i = 1; i <= 4; i++)
+			AbortIfNot(sig.raise(i, ""), false);
+
+		const bool posted = sig.raise(5, "");
+		AbortIfNot(posted == (policy == Signal::overflow::drop_oldest),
+			false);
+		AbortIfNot(pool.dropped() == 1, false);
+
+		handler.hold.store(false);
+		pool.drain();
+
+		AbortIfNot(handler.calls.load() == 5, false);
+
+		const long expected = policy == Signal::overflow::drop_oldest ?
+			1000 + 2 + 3 + 4 + 5 : 1000 + 1 + 2 + 3 + 4;
+		AbortIfNot(handler.total.load() == expected, false);
+
+		return true;
+	}
+};
+
+namespace batch_funcs
+{
+	int sum(int a, int b)
+	{
+		return a + b;
+	}
 }
 
-bool test_sig1()
+class batch_handler
 {
-	Signal::Signal<void,net::DataBuffer&>
-		sig;
 
-	AbortIfNot(sig.attach(&func), false);
+public:
 
-	net::DataBuffer buf;
-	sig.forward(buf);
+	batch_handler() : total(0)
+	{
+	}
 
-	sig.raise();
+	int scale(int a, int b) const
+	{
+		return a * b;
+	}
 
-	std::printf("%s: buffer is %zu bytes.\n",
-				__FUNCTION__, buf.size());
-	std::fflush(stdout);
+	void add(int a, int b)
+	{
+		total += a + b;
+	}
 
-	return true;
-}
+	int operator()(int a, int b)
+	{
+		return a - b;
+	}
 
-bool test_sig2()
+	int total;
+};
+
+class batch_test
 {
-	Test test;
-	Signal::Signal<void,net::DataBuffer&>
-		sig;
 
-	AbortIfNot(sig.attach(test, &Test::func), false);
+public:
 
-	net::DataBuffer buf;
-	sig.forward(buf);
+	bool run()
+	{
+		batch_handler obj;
 
-	sig.raise();
+		const std::tuple<int,int> args[] = {
+			std::make_tuple(1, 2),
+			std::make_tuple(3, 4),
+			std::make_tuple(5, 6)
+		};
 
-	std::printf("%s: buffer is %zu bytes.\n",
-				__FUNCTION__, buf.size());
-	std::fflush(stdout);
+		const int a[] = { 1, 3, 5 };
+		const int b[] = { 2, 4, 6 };
 
-	return true;
-}
+		int results[3] = { 0 };
 
-bool test_sig3()
+		Signal::fcn_ptr<int,int,int> fcn(&batch_funcs::sum);
+		fcn.raise_batch(args, 3, results);
+		AbortIfNot(results[0] == 3 && results[2] == 11, false);
+
+		Signal::mem_ptr<int,batch_handler,int,int> mem(obj,
+			&batch_handler::scale);
+		mem.raise_batch(Signal::columns(a, b), 3, results);
+		AbortIfNot(results[0] == 2 && results[2] == 30, false);
+
+		Signal::Signal<void,int,int> sig(obj, &batch_handler::add);
+		sig.raise_batch(args, 3);
+		sig.raise_batch(Signal::columns(a, b), 3);
+		AbortIfNot(obj.total == 42, false);
+
+		Signal::Signal<int,int,int> sig2(&batch_funcs::sum);
+		sig2.raise_batch(Signal::columns(a, b), 3, results);
+		AbortIfNot(results[1] == 7, false);
+
+		Signal::Callable<batch_handler> callable(obj);
+		callable.raise_batch(args, 3, results);
+		AbortIfNot(results[0] == -1 && results[2] == -1, false);
+
+		return true;
+	}
+};
+
+/*
+ * Counts how often it is copied or moved
+ */
+class tracked
 {
-	Test test;
-	Signal::Signal<void,net::DataBuffer>
-		sig;
 
-	AbortIfNot(sig.attach(test, &Test::func2), false);
+public:
 
-	net::DataBuffer buf(nullptr, 10);
-	sig.forward(buf);
+	tracked()
+	{
+	}
 
-	/*
-	 * By-value call using stored pointers:
-	 */
-	sig.raise();
+	tracked(const tracked&)
+	{
+		copies++;
+	}
 
-	return true;
+	tracked(tracked&&) noexcept
+	{
+		moves++;
+	}
+
+	tracked& operator=(const tracked&) = default;
+	tracked& operator=(tracked&&) noexcept = default;
+
+	static void reset()
+	{
+		copies = 0; moves = 0;
+	}
+
+	static int copies;
+	static int moves;
+};
+
+int tracked::copies = 0;
+int tracked::moves  = 0;
+
+namespace forwarding_funcs
+{
+	void by_value(tracked)
+	{
+	}
+
+	void by_ref(const tracked&)
+	{
+	}
 }
 
-int main()
+class forwarding_handler
 {
-	mem_ptr_test test1;
-	AbortIfNot(test1.run(), 1);
 
-	std::cout << "\n";
-	
-	fcn_ptr_test test2;
-	AbortIfNot(test2.run(), 1);
+public:
 
-	std::cout << "\n";
+	void by_value(tracked) const
+	{
+	}
+};
 
-	signal_test test3;
-	AbortIfNot(test3.run(), 1);
+class forwarding_test
+{
 
-	callable_test test4;
+public:
+
+	bool run()
+	{
+		forwarding_handler obj;
+		tracked t;
+
+		/*
+		 * By value: one copy into raise(), then moved into the handler
+		 */
+		Signal::Signal<void,tracked> sig1(&forwarding_funcs::by_value);
+
+		tracked::reset();
+		sig1.raise(t);
+		AbortIfNot(tracked::copies == 1 && tracked::moves == 1, false);
+
+		tracked::reset();
+		sig1.raise(tracked());
+		AbortIfNot(tracked::copies == 0, false);
+
+		Signal::Signal<void,tracked> sig2(obj, &forwarding_handler::by_value);
+
+		tracked::reset();
+		sig2.raise(t);
+		AbortIfNot(tracked::copies == 1 && tracked::moves == 1, false);
+
+		Signal::fcn_ptr<void,tracked> fcn(&forwarding_funcs::by_value);
+		Signal::signal_t<void,tracked>* base = &fcn;
+
+		tracked::reset();
+		base->raise(t);
+		AbortIfNot(tracked::copies == 1 && tracked::moves == 1, false);
+
+		/*
+		 * By reference: never copied
+		 */
+		Signal::Signal<void,const tracked&> sig3(&forwarding_funcs::by_ref);
+
+		tracked::reset();
+		sig3.raise(t);
+		AbortIfNot(tracked::copies == 0 && tracked::moves == 0, false);
+
+		/*
+		 * Bound by value: the bound copy is kept, so each raise() makes
+		 * the one copy the handler needs
+		 */
+		sig1.bind(t);
+
+		tracked::reset();
+		sig1.raise();
+		AbortIfNot(tracked::copies == 1 && tracked::moves == 1, false);
+
+		/*
+		 * Multicast: exactly one copy per by-value handler
+		 */
+		Signal::Multicast<void,tracked> multicast;
+		multicast.connect(&forwarding_funcs::by_value);
+		multicast.connect(obj, &forwarding_handler::by_value);
+
+		tracked::reset();
+		multicast.raise(t);
+		AbortIfNot(tracked::copies == 2 && tracked::moves == 0, false);
+
+		return true;
+	}
+};
+
+class bind_test
+{
+
+public:
+
+	bool run()
+	{
+		forwarding_handler obj;
+		tracked t;
+
+		Signal::Signal<void,tracked> sig1(&forwarding_funcs::by_value);
+		Signal::Signal<void,tracked> sig2(obj, &forwarding_handler::by_value);
+
+		/*
+		 * Binding an lvalue makes a single copy; an rvalue is moved
+		 */
+		tracked::reset();
+		sig1.bind(t);
+		AbortIfNot(tracked::copies == 1, false);
+
+		tracked::reset();
+		sig1.bind(tracked());
+		AbortIfNot(tracked::copies == 0, false);
+
+		/*
+		 * Ordinary bound arguments are copied into the handler, while
+		 * those bound with bind_once() are moved
+		 */
+		tracked::reset();
+		sig1.raise();
+		AbortIfNot(tracked::copies == 1, false);
+
+		sig1.bind_once(tracked());
+
+		tracked::reset();
+		sig1.raise();
+		AbortIfNot(tracked::copies == 0 && tracked::moves == 1, false);
+
+		sig2.bind_once(tracked());
+
+		tracked::reset();
+		sig2.raise();
+		AbortIfNot(tracked::copies == 0 && tracked::moves == 1, false);
+
+		/*
+		 * Binding again reverts to copying
+		 */
+		sig2.bind(tracked());
+
+		tracked::reset();
+		sig2.raise();
+		AbortIfNot(tracked::copies == 1, false);
+
+		Signal::fcn_ptr<void,tracked> fcn(&forwarding_funcs::by_value);
+		fcn.bind_once(t);
+
+		tracked::reset();
+		fcn.raise();
+		AbortIfNot(tracked::copies == 0 && tracked::moves == 1, false);
+
+		/*
+		 * Bound by reference: the bound copy is passed as-is
+		 */
+		Signal::Signal<void,const tracked&> sig3(&forwarding_funcs::by_ref);
+		sig3.bind_once(t);
+
+		tracked::reset();
+		sig3.raise();
+		AbortIfNot(tracked::copies == 0 && tracked::moves == 0, false);
+
+		return true;
+	}
+};
+
+class retarget_a
+{
+
+public:
+
+	retarget_a() : value(0)
+	{
+	}
+
+	void set1(int x) { value = x; }
+	void set2(int x) { value = 2*x; }
+	void get3(int x) const { last = 3*x; }
+
+	int value;
+	mutable int last;
+};
+
+class retarget_b
+{
+
+public:
+
+	void set(int)
+	{
+	}
+};
+
+class retarget_test
+{
+
+public:
+
+	bool run()
+	{
+		retarget_a a;
+
+		Signal::Signal<void,int> sig(a, &retarget_a::set1);
+
+		/*
+		 * Re-targeting within the same class keeps the object
+		 */
+		AbortIfNot(sig.attach(&retarget_a::set2), false);
+		sig.raise(4);
+		AbortIfNot(a.value == 8, false);
+
+		AbortIfNot(sig.attach(&retarget_a::get3), false);
+		sig.raise(4);
+		AbortIfNot(a.last == 12, false);
+
+		/*
+		 * A method of any other class is rejected, as is re-targeting
+		 * a signal whose handler is not a method
+		 */
+		AbortIf(sig.attach(&retarget_b::set), false);
+
+		Signal::Signal<void,int> copy(sig);
+		AbortIf(copy.attach(&retarget_b::set), false);
+		AbortIfNot(copy.attach(&retarget_a::set1), false);
+
+		Signal::Signal<void,int> fcn(&multicast_funcs::add);
+		AbortIf(fcn.attach(&retarget_a::set1), false);
+
+		sig.detach();
+		AbortIf(sig.attach(&retarget_a::set1), false);
+
+		return true;
+	}
+};
+
+class static_test
+{
+
+public:
+
+	bool run()
+	{
+		retarget_a a;
+
+		typedef Signal::static_fcn<decltype(&multicast_funcs::add),
+			&multicast_funcs::add> fcn_type;
+		typedef Signal::static_mem<decltype(&retarget_a::set2),
+			&retarget_a::set2> mem_type;
+		typedef Signal::static_mem<decltype(&retarget_a::get3),
+			&retarget_a::get3> const_type;
+
+		static_assert(std::is_empty<fcn_type>::value,
+			"static_fcn should be empty");
+		static_assert(sizeof(mem_type) == sizeof(void*),
+			"static_mem should be one pointer");
+		static_assert(sizeof(const_type) == sizeof(void*),
+			"static_mem should be one pointer");
+
+		fcn_type fcn;
+		mem_type mem(a);
+
+		const retarget_a& ca = a;
+		const_type cmem(ca);
+
+		AbortIfNot(fcn.is_connected(), false);
+
+		multicast_funcs::total = 0;
+		fcn.raise(5);
+		AbortIfNot(multicast_funcs::total == 5, false);
+
+		mem.raise(3);
+		AbortIfNot(a.value == 6, false);
+
+		cmem.raise(3);
+		AbortIfNot(a.last == 9, false);
+
+		Signal::static_fcn<decltype(&batch_funcs::sum),
+			&batch_funcs::sum> sum;
+
+		int x[] = { 1, 2, 3 };
+		int y[] = { 4, 5, 6 };
+		int results[3];
+
+		sum.raise_batch(Signal::columns(x, y), 3, results);
+		AbortIfNot(results[0] == 5 && results[2] == 9, false);
+
+		mem.raise_batch(Signal::columns(x), 3);
+		AbortIfNot(a.value == 6, false);
+
+		return true;
+	}
+};
+
+class pool_test
+{
+
+public:
+
+	bool run()
+	{
+		retarget_a a;
+
+		Signal::Signal<void,int> sig(a, &retarget_a::set1);
+		Signal::fcn_ptr<void,int> fcn(&multicast_funcs::add);
+		Signal::Multicast<void,int> multicast;
+		multicast.connect(a, &retarget_a::set2);
+
+		const std::size_t largest =
+			std::max(sizeof(Signal::Signal<void,int>),
+					 sizeof(Signal::Multicast<void,int>));
+
+		Signal::pool mem(largest, 2);
+		AbortIfNot(mem.block_size() >= largest, false);
+
+		sig.bind(7);
+		fcn.bind(3);
+		multicast.bind(5);
+
+		/*
+		 * Clones drawn from the pool behave just like the originals
+		 */
+		Signal::generic* copies[3] = {
+			sig.clone(mem), fcn.clone(mem), multicast.clone(mem) };
+
+		multicast_funcs::total = 0;
+
+		copies[0]->v_raise();
+		AbortIfNot(a.value == 7, false);
+		copies[1]->v_raise();
+		AbortIfNot(multicast_funcs::total == 3, false);
+		copies[2]->v_raise();
+		AbortIfNot(a.value == 10, false);
+
+		/*
+		 * A disposed block is handed out again
+		 */
+		void* block = copies[1];
+		Signal::dispose(copies[1], mem);
+
+		copies[1] = sig.clone(mem);
+		AbortIfNot(copies[1] == block, false);
+
+		for (int i = 0; i < 3; i++)
+			Signal::dispose(copies[i], mem);
+
+		/*
+		 * After a reset, blocks are carved from the first chunk again
+		 */
+		mem.reset();
+
+		Signal::generic* first = sig.clone(mem);
+		first->~generic();
+		mem.reset();
+		AbortIfNot(sig.clone(mem) == first, false);
+		mem.reset();
+
+		bool thrown = false;
+		try
+		{
+			Signal::pool small(1);
+			sig.clone(small);
+		}
+		catch (const std::bad_alloc&)
+		{
+			thrown = true;
+		}
+
+		AbortIfNot(thrown, false);
+
+		return true;
+	}
+};
+
+class registry_test
+{
+
+public:
+
+	bool run()
+	{
+		retarget_a a;
+
+		Signal::Signal<void,int> sig(a, &retarget_a::set1);
+		sig.bind(4);
+
+		Signal::SignalRegistry registry(64);
+
+		/*
+		 * IDs are dense and assigned in order
+		 */
+		typedef Signal::fcn_ptr<void,int>   fcn_type;
+		typedef Signal::Multicast<void,int> multicast_type;
+
+		const std::size_t id0 = registry.add(sig);
+		const std::size_t id1 =
+			registry.emplace<fcn_type>(&multicast_funcs::add);
+		const std::size_t id2 = registry.emplace<multicast_type>();
+
+		AbortIfNot(id0 == 0 && id1 == 1 && id2 == 2, false);
+		AbortIfNot(registry.size() == 3, false);
+
+		static_cast<fcn_type&>(registry.get(1)).bind(2);
+
+		auto& multicast = static_cast<multicast_type&>(registry.get(2));
+		multicast.connect(&multicast_funcs::add);
+		multicast.bind(10);
+
+		multicast_funcs::total = 0;
+
+		registry.raise(0);
+		AbortIfNot(a.value == 4, false);
+
+		registry.raise(1);
+		AbortIfNot(multicast_funcs::total == 2, false);
+
+		a.value = 0;
+		registry.raise_all();
+		AbortIfNot(a.value == 4 && multicast_funcs::total == 14, false);
+
+		/*
+		 * Signals larger than a chunk still fit
+		 */
+		for (int i = 0; i < 100; i++)
+			registry.add(sig);
+
+		AbortIfNot(registry.size() == 103, false);
+
+		registry.clear();
+		AbortIfNot(registry.size() == 0, false);
+		AbortIfNot(registry.add(sig) == 0, false);
+
+		return true;
+	}
+};
+
+namespace command_funcs
+{
+	std::string log;
+
+	void append(const std::string& str)
+	{
+		log += str;
+	}
+
+	void append_char(char c)
+	{
+		log += c;
+	}
+
+	/*
+	 * An argument whose copies and moves throw while fail is set
+	 */
+	struct fragile
+	{
+		explicit fragile(char c) : c(c)
+		{
+		}
+
+		fragile(const fragile& other) : c(other.c)
+		{
+			if (fail) throw std::runtime_error("copy");
+		}
+
+		fragile(fragile&& other) : c(other.c)
+		{
+			if (fail) throw std::runtime_error("move");
+		}
+
+		char c;
+		static bool fail;
+	};
+
+	bool fragile::fail = false;
+
+	void append_fragile(const fragile& f)
+	{
+		log += f.c;
+	}
+}
+
+class command_test
+{
+
+public:
+
+	bool run()
+	{
+		retarget_a a;
+
+		Signal::Signal<void,int> sig(a, &retarget_a::set1);
+		Signal::CommandBuffer buffer(64);
+
+		/*
+		 * Record enough calls that the buffer has to grow, so that
+		 * commands holding a std::string get relocated
+		 */
+		for (int i = 0; i < 10; i++)
+		{
+			buffer.record(&command_funcs::append, std::string(20, 'a' + i));
+			buffer.record(&command_funcs::append_char, '-');
+		}
+
+		buffer.record(a, &retarget_a::set2, 5);
+		buffer.record(static_cast<const retarget_a&>(a),
+			&retarget_a::get3, 5);
+		buffer.record(sig, 1);
+
+		AbortIfNot(buffer.size() == 23, false);
+		AbortIfNot(buffer.capacity() > 64, false);
+
+		command_funcs::log.clear();
+		buffer.replay();
+
+		AbortIfNot(command_funcs::log.size() == 210, false);
+		AbortIfNot(command_funcs::log.substr(0, 22) ==
+			std::string(20, 'a') + "-b", false);
+
+		/*
+		 * Calls are made in order: set2 before raising sig
+		 */
+		AbortIfNot(a.value == 1 && a.last == 15, false);
+
+		/*
+		 * Recorded calls may be replayed again
+		 */
+		buffer.replay();
+		AbortIfNot(command_funcs::log.size() == 420, false);
+
+		/*
+		 * Clearing keeps the memory
+		 */
+		const std::size_t capacity = buffer.capacity();
+		buffer.clear();
+
+		AbortIfNot(buffer.empty() && buffer.used() == 0, false);
+		AbortIfNot(buffer.capacity() == capacity, false);
+
+		buffer.record(&command_funcs::append_char, 'z');
+
+		command_funcs::log.clear();
+		buffer.replay();
+		AbortIfNot(command_funcs::log == "z", false);
+
+		/*
+		 * If relocating a call throws, the buffer is left as it was
+		 */
+		Signal::CommandBuffer small(64);
+		small.record(&command_funcs::append, std::string(20, 'x'));
+		small.record(&command_funcs::append_fragile,
+			command_funcs::fragile('y'));
+
+		const std::size_t small_used = small.used();
+		const std::size_t small_capacity = small.capacity();
+
+		bool thrown = false;
+		command_funcs::fragile::fail = true;
+		try
+		{
+			small.reserve(2 * small_capacity);
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+		command_funcs::fragile::fail = false;
+
+		AbortIfNot(thrown, false);
+		AbortIfNot(small.size() == 2 && small.used() == small_used,
+			false);
+		AbortIfNot(small.capacity() == small_capacity, false);
+
+		command_funcs::log.clear();
+		small.replay();
+		AbortIfNot(command_funcs::log == std::string(20, 'x') + "y",
+			false);
+
+		small.reserve(2 * small_capacity);
+		command_funcs::log.clear();
+		small.replay();
+		AbortIfNot(command_funcs::log == std::string(20, 'x') + "y",
+			false);
+
+		return true;
+	}
+};
+
+class copy_test
+{
+
+public:
+
+	bool run()
+	{
+		typedef Signal::Signal<void,int> signal_type;
+
+		static_assert(std::is_nothrow_move_constructible<
+			signal_type>::value, "Signal moves should not throw");
+		static_assert(std::is_nothrow_move_assignable<
+			signal_type>::value, "Signal moves should not throw");
+
+		retarget_a a;
+
+		/*
+		 * Clones and copies keep the handler and bound arguments
+		 */
+		signal_type sig(a, &retarget_a::set1);
+		sig.bind(3);
+
+		Signal::generic* clone = sig.clone();
+		clone->v_raise();
+		AbortIfNot(a.value == 3, false);
+		delete clone;
+
+		/*
+		 * Growing a vector moves its Signals rather than copying them
+		 */
+		std::vector<Signal::Signal<void,tracked>> signals;
+		for (int i = 0; i < 100; i++)
+		{
+			signals.emplace_back(&forwarding_funcs::by_value);
+			signals.back().bind(tracked());
+		}
+
+		tracked::reset();
+		signals.reserve(1000);
+		AbortIfNot(tracked::copies == 0 && tracked::moves == 100, false);
+
+		std::vector<signal_type> vec;
+		for (int i = 0; i < 100; i++)
+			vec.push_back(sig);
+
+		vec.back().raise(4);
+		AbortIfNot(a.value == 4, false);
+
+		/*
+		 * Deep copies are independent
+		 */
+		signal_type deep(sig);
+		deep.bind(5);
+		sig.raise();
+		AbortIfNot(a.value == 3, false);
+
+		/*
+		 * Shared copies see each other's bound arguments and targets
+		 */
+		sig.set_policy(Signal::copy_policy::share);
+
+		signal_type shared1(sig);
+		signal_type shared2;
+		shared2 = shared1;
+
+		AbortIfNot(shared2.policy() == Signal::copy_policy::share,
+			false);
+
+		shared1.bind(6);
+		sig.raise();
+		AbortIfNot(a.value == 6, false);
+
+		AbortIfNot(shared2.attach(&retarget_a::get3), false);
+		sig.raise(2);
+		AbortIfNot(a.last == 6, false);
+		shared1.raise(3);
+		AbortIfNot(a.last == 9, false);
+
+		/*
+		 * A moved shared Signal still shares
+		 */
+		signal_type moved(std::move(shared1));
+		AbortIf(shared1.is_connected(), false);
+
+		AbortIfNot(moved.attach(&retarget_a::set2), false);
+		shared2.raise(4);
+		AbortIfNot(a.value == 8, false);
+
+		/*
+		 * Attaching a new handler leaves the others alone
+		 */
+		AbortIfNot(moved.attach(a, &retarget_a::set1), false);
+		moved.raise(1);
+		AbortIfNot(a.value == 1, false);
+		sig.raise(1);
+		AbortIfNot(a.value == 2, false);
+
+		/*
+		 * Going back to deep copies takes a private copy
+		 */
+		shared2.set_policy(Signal::copy_policy::deep);
+		shared2.bind(10);
+		sig.raise();
+		AbortIfNot(a.value == 12, false);
+		shared2.raise();
+		AbortIfNot(a.value == 20, false);
+		shared2.raise(7);
+		AbortIfNot(a.value == 14, false);
+
+		return true;
+	}
+};
+
+class delegate_test
+{
+
+public:
+
+	bool run()
+	{
+		typedef Signal::Delegate<void,int> delegate;
+
+		static_assert(std::is_trivially_copyable<delegate>::value,
+			"Delegates should be trivially copyable");
+		static_assert(sizeof(delegate) == 2 * sizeof(void*),
+			"Delegates should be two pointers");
+
+		retarget_a a;
+
+		delegate empty;
+		AbortIf(empty.is_connected(), false);
+
+		delegate table[4] = {
+			delegate(&multicast_funcs::add),
+			delegate::from<&multicast_funcs::add>(),
+			delegate::from<retarget_a, &retarget_a::set2>(a),
+			delegate::from<retarget_a, &retarget_a::get3>(a)
+		};
+
+		/*
+		 * Relocate the table with memcpy
+		 */
+		delegate copy[4];
+		std::memcpy(copy, table, sizeof(table));
+
+		multicast_funcs::total = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			AbortIfNot(copy[i].is_connected(), false);
+			copy[i].raise(5);
+		}
+
+		AbortIfNot(multicast_funcs::total == 10, false);
+		AbortIfNot(a.value == 10 && a.last == 15, false);
+
+		AbortIfNot(copy[2] == table[2], false);
+		AbortIf(copy[0] == copy[1], false);
+		AbortIfNot(delegate(&multicast_funcs::add) == copy[0], false);
+
+		Signal::Delegate<int,int,int> sum(&batch_funcs::sum);
+		AbortIfNot(sum.raise(2, 3) == 5, false);
+
+		return true;
+	}
+};
+
+namespace priority_funcs
+{
+	int order[8];
+	int calls = 0;
+
+	bool first(int a)  { order[calls++] = 1; return a > 0; }
+	bool second(int a) { order[calls++] = 2; return a > 1; }
+	bool third(int a)  { order[calls++] = 3; return a > 2; }
+	bool fourth(int a) { order[calls++] = 4; return a > 3; }
+
+	int times2(int a)  { return 2 * a; }
+	int times3(int a)  { return 3 * a; }
+	int negate(int a)  { return -a; }
+}
+
+class priority_test
+{
+
+public:
+
+	bool run()
+	{
+		using namespace priority_funcs;
+
+		Signal::Multicast<bool,int> chain;
+
+		/*
+		 * Connect out of order. Higher priorities go first, and equal
+		 * priorities in the order connected:
+		 */
+		chain.connect(-1, &fourth);
+		chain.connect(&second);
+		chain.connect(5, &first);
+		Signal::connection conn = chain.connect(&third);
+
+		calls = 0;
+		chain.raise(0);
+		AbortIfNot(calls == 4, false);
+		AbortIfNot(order[0] == 1 && order[1] == 2, false);
+		AbortIfNot(order[2] == 3 && order[3] == 4, false);
+
+		/*
+		 * Stop at the first handler that returns false:
+		 */
+		Signal::first_false all_pass;
+		calls = 0;
+		AbortIfNot(chain.raise_with(all_pass, 10), false);
+		AbortIfNot(calls == 4, false);
+
+		Signal::first_false fails;
+		calls = 0;
+		AbortIf(chain.raise_with(fails, 2), false);
+		AbortIfNot(calls == 3 && order[2] == 3, false);
+
+		AbortIfNot(chain.disconnect(conn), false);
+
+		Signal::first_false after;
+		calls = 0;
+		AbortIfNot(chain.raise_with(after, 10), false);
+		AbortIfNot(calls == 3 && order[2] == 4, false);
+
+		Signal::Multicast<int,int> values;
+
+		Signal::maximum<int> none;
+		AbortIfNot(values.raise_with(none, 1) == 0, false);
+		AbortIfNot(none.empty(), false);
+
+		values.connect(&times2);
+		values.connect(1, &negate);
+		values.connect(&times3);
+
+		Signal::sum<long> total;
+		AbortIfNot(values.raise_with(total, 4) == 16, false);
+
+		Signal::maximum<int> largest;
+		AbortIfNot(values.raise_with(largest, 4) == 12, false);
+		AbortIf(largest.empty(), false);
+
+		/*
+		 * Collect into a buffer too small for every return value:
+		 */
+		int buf[2];
+		Signal::collect<int> results(buf, 2);
+		AbortIfNot(values.raise_with(results, 5) == 2, false);
+		AbortIfNot(buf[0] == -5 && buf[1] == 10, false);
+
+		return true;
+	}
+};
+
+class instrument_test
+{
+
+public:
+
+	bool run()
+	{
+		/*
+		 * Buckets are exact up to 8ns, then 8 to a power of two:
+		 */
+		for (std::uint64_t ns = 0; ns < 8; ns++)
+			AbortIfNot(Signal::stats::bucket_of(ns) == ns, false);
+
+		AbortIfNot(Signal::stats::bucket_of(8)   == 8,  false);
+		AbortIfNot(Signal::stats::bucket_of(16)  == 16, false);
+		AbortIfNot(Signal::stats::bucket_of(17)  == 16, false);
+		AbortIfNot(Signal::stats::bucket_of(1048576) ==
+				   Signal::stats::bucket_of(1148576), false);
+		AbortIfNot(Signal::stats::bucket_of(~std::uint64_t(0)) ==
+				   Signal::stats::buckets - 1, false);
+
+		for (std::size_t i = 0; i < Signal::stats::buckets - 1; i++)
+		{
+			const std::uint64_t high = Signal::stats::bucket_high(i);
+			AbortIfNot(Signal::stats::bucket_of(high)     == i, false);
+			AbortIfNot(Signal::stats::bucket_of(high + 1) == i+1, false);
+		}
+
+		Signal::stats manual("manual");
+		for (std::uint64_t ns = 1; ns <= 100; ns++)
+			manual.record(ns);
+
+		Signal::stats::summary summary = manual.snapshot();
+		AbortIfNot(summary.count == 100, false);
+		AbortIfNot(summary.min == 1 && summary.max == 100, false);
+		AbortIfNot(summary.mean() == 50.5, false);
+		AbortIfNot(summary.percentile(50)  >= 50 &&
+				   summary.percentile(50)  <= 55, false);
+		AbortIfNot(summary.percentile(100) == 100, false);
+
+#ifdef SIGNAL_INSTRUMENT
+		/*
+		 * Record from several threads at once. This needs the hooks
+		 * built into Signal, which the signal_ut_instrument build of
+		 * this file does:
+		 */
+		Signal::stats raises("raises");
+
+		Signal::Signal<void,int> sig(&multicast_funcs::add);
+		sig.set_stats(&raises);
+
+		Signal::Signal<void,int> copy(sig);
+		AbortIfNot(copy.get_stats() == &raises, false);
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; t++)
+		{
+			threads.emplace_back([&raises]() {
+				Signal::Signal<int,int> mine(&priority_funcs::negate);
+				mine.set_stats(&raises);
+
+				for (int i = 0; i < 1000; i++)
+					mine.raise(i);
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		sig.bind(1);
+		sig.v_raise();
+		copy.raise(2);
+
+		AbortIfNot(raises.snapshot().count == 4002, false);
+
+		sig.set_stats(nullptr);
+		sig.raise(3);
+		AbortIfNot(raises.snapshot().count == 4002, false);
+
+		Signal::stats::summary all = Signal::stats::aggregate();
+		AbortIfNot(all.count >= 4102, false);
+
+		std::ostringstream dump;
+		Signal::stats::dump_all(dump);
+		AbortIf(dump.str().find("raises: calls=4002") ==
+				std::string::npos, false);
+		AbortIf(dump.str().find("manual: calls=100") ==
+				std::string::npos, false);
+
+		raises.reset();
+		AbortIfNot(raises.snapshot().count == 0, false);
+#endif
+
+		return true;
+	}
+};
+
+class subscriber
+{
+
+public:
+
+	subscriber(Signal::Multicast<void,int>& sig)
+		: calls(0), conn(sig, sig.connect(*this, &subscriber::handle))
+	{
+	}
+
+	void handle(int)
+	{
+		calls++;
+	}
+
+	int calls;
+
+	Signal::scoped_connection conn;
+};
+
+/*
+ * Disconnects handlers while the signal is being raised
+ */
+class disconnector
+{
+
+public:
+
+	disconnector() : calls(0), sig(nullptr)
+	{
+	}
+
+	void handle(int)
+	{
+		calls++;
+		for (std::size_t i = 0; i < conns.size(); i++)
+			sig->disconnect(conns[i]);
+	}
+
+	int calls;
+
+	std::vector<Signal::connection> conns;
+
+	Signal::Multicast<void,int>* sig;
+};
+
+class scoped_test
+{
+
+public:
+
+	bool run()
+	{
+		Signal::Multicast<void,int> sig;
+
+		{
+			subscriber first(sig);
+			subscriber second(sig);
+			AbortIfNot(sig.size() == 2, false);
+
+			sig.raise(1);
+			AbortIfNot(first.calls == 1 && second.calls == 1, false);
+		}
+
+		AbortIfNot(sig.size() == 0, false);
+		AbortIf(sig.is_connected(), false);
+
+		/*
+		 * Moving hands over the connection, and release() keeps it:
+		 */
+		static_assert(
+			std::is_nothrow_move_constructible<
+				Signal::scoped_connection>::value &&
+			std::is_nothrow_move_assignable<
+				Signal::scoped_connection>::value,
+			"A vector of scoped_connections should move them on growth");
+
+		Signal::scoped_connection outer;
+		{
+			multicast_funcs::total = 0;
+			Signal::scoped_connection inner(
+				sig, sig.connect(&multicast_funcs::add));
+			outer = std::move(inner);
+			AbortIf(inner.get().is_valid(), false);
+		}
+
+		sig.raise(2);
+		AbortIfNot(multicast_funcs::total == 2, false);
+
+		const Signal::connection kept = outer.release();
+		outer = Signal::scoped_connection();
+		AbortIfNot(sig.is_connected(kept), false);
+
+		Signal::scoped_connection again(sig, kept);
+		AbortIfNot(again.disconnect(), false);
+		AbortIf(again.disconnect(), false);
+		AbortIf(sig.is_connected(kept), false);
+
+		/*
+		 * Stale connections never match a handler that reuses their
+		 * slot:
+		 */
+		Signal::connection reused = sig.connect(&multicast_funcs::add);
+		AbortIf(reused == kept, false);
+		AbortIf(sig.disconnect(kept), false);
+		AbortIfNot(sig.is_connected(reused), false);
+		AbortIfNot(sig.disconnect(reused), false);
+
+		/*
+		 * Connections only match the signal that made them, not
+		 * another one, or a copy, whose handler has the same ID:
+		 */
+		Signal::Multicast<void,int> sig_a, sig_b;
+		Signal::connection conn_a = sig_a.connect(&multicast_funcs::add);
+		Signal::connection conn_b = sig_b.connect(&multicast_funcs::add);
+		AbortIf(conn_a == conn_b, false);
+		AbortIf(sig_b.is_connected(conn_a), false);
+		AbortIf(sig_b.disconnect(conn_a), false);
+		AbortIfNot(sig_a.is_connected(conn_a), false);
+
+		Signal::Multicast<void,int> sig_c(sig_a);
+		AbortIfNot(sig_c.size() == 1, false);
+		AbortIf(sig_c.disconnect(conn_a), false);
+		sig_b = sig_a;
+		AbortIf(sig_b.is_connected(conn_b), false);
+		AbortIfNot(sig_a.disconnect(conn_a), false);
+
+		/*
+		 * A handler that disconnects itself, one already invoked and
+		 * one not yet invoked:
+		 */
+		disconnector d;
+		counter before, after;
+
+		d.sig = &sig;
+		d.conns.push_back(sig.connect(before, &counter::add));
+		d.conns.push_back(sig.connect(d, &disconnector::handle));
+		d.conns.push_back(sig.connect(after, &counter::add));
+
+		sig.raise(3);
+		AbortIfNot(before.calls == 1 && d.calls == 1, false);
+		AbortIfNot(after.calls == 0, false);
+		AbortIfNot(sig.size() == 0, false);
+
+		sig.raise(4);
+		AbortIfNot(before.calls == 1 && d.calls == 1, false);
+
+		/*
+		 * Order survives compaction:
+		 */
+		Signal::Multicast<int,int> values;
+		std::vector<Signal::connection> value_conns;
+		value_conns.push_back(values.connect(3, &priority_funcs::times2));
+		value_conns.push_back(values.connect(2, &priority_funcs::negate));
+		value_conns.push_back(values.connect(1, &priority_funcs::times3));
+		value_conns.push_back(values.connect(0, &priority_funcs::negate));
+
+		AbortIfNot(values.disconnect(value_conns[1]), false);
+		AbortIfNot(values.disconnect(value_conns[3]), false);
+		AbortIfNot(values.size() == 2, false);
+
+		int buf[4];
+		Signal::collect<int> results(buf, 4);
+		AbortIfNot(values.raise_with(results, 5) == 2, false);
+		AbortIfNot(buf[0] == 10 && buf[1] == 15, false);
+
+		values.connect(2, &priority_funcs::negate);
+		Signal::collect<int> more(buf, 4);
+		AbortIfNot(values.raise_with(more, 5) == 3, false);
+		AbortIfNot(buf[1] == -5, false);
+
+		return true;
+	}
+};
+
+/*
+ * Signals should take up the same, small amount of space whatever
+ * arguments they take, since bound arguments are either kept in a
+ * fixed two-pointer slot or allocated when bound. In pointers: the
+ * vtable, the bound arguments (two) and the handler (two for member
+ * functions, which also need the object and a flag)
+ */
+class size_test
+{
+
+public:
+
+	typedef Signal::fcn_ptr<void,int>                       fcn_1;
+	typedef Signal::fcn_ptr<int,const std::string&,int>     fcn_2;
+	typedef Signal::mem_ptr<void,counter,int>               mem_1;
+	typedef Signal::mem_ptr<int,counter,const std::string&,int> mem_2;
+	typedef Signal::Signal<void>                            sig_0;
+	typedef Signal::Signal<void,int>                        sig_1;
+	typedef Signal::Signal<int,const std::string&,int>      sig_2;
+	typedef Signal::Signal<void,std::string>                sig_3;
+
+	static const std::size_t ptr = sizeof(void*);
+
+#ifdef SIGNAL_INSTRUMENT
+	static const std::size_t stats_ptr = 1;
+#else
+	static const std::size_t stats_ptr = 0;
+#endif
+
+	static_assert(sizeof(fcn_1) <= 4 * ptr, "fcn_ptr is too large");
+	static_assert(sizeof(fcn_2) == sizeof(fcn_1),
+		"fcn_ptr size should not depend on its arguments");
+
+	static_assert(sizeof(mem_1) <= 7 * ptr, "mem_ptr is too large");
+	static_assert(sizeof(mem_2) == sizeof(mem_1),
+		"mem_ptr size should not depend on its arguments");
+
+	static_assert(sizeof(sig_1) <= (12 + stats_ptr) * ptr,
+		"Signal is too large");
+	static_assert(sizeof(sig_0) == sizeof(sig_1) &&
+				  sizeof(sig_2) == sizeof(sig_1) &&
+				  sizeof(sig_3) == sizeof(sig_1),
+		"Signal size should not depend on its arguments");
+
+	bool run()
+	{
+		std::cout << "sizeof(fcn_ptr<void,int>)                  = "
+			<< sizeof(fcn_1) << "\n"
+			<< "sizeof(mem_ptr<void,C,int>)                = "
+			<< sizeof(mem_1) << "\n"
+			<< "sizeof(Signal<void>)                       = "
+			<< sizeof(sig_0) << "\n"
+			<< "sizeof(Signal<int,const std::string&,int>) = "
+			<< sizeof(sig_2) << std::endl;
+
+		/*
+		 * Arguments too large to keep inline are not allocated until
+		 * they are bound. Until then, raise() passes default values
+		 */
+		std::string last = "none";
+		sig_3 big([&last](std::string str) { last = str; });
+
+		big.raise();
+		AbortIfNot(last.empty(), false);
+
+		big.bind("bound");
+		sig_3 big_copy(big);
+		big_copy.raise();
+		AbortIfNot(last == "bound", false);
+
+		/*
+		 * Small arguments are kept inline
+		 */
+		Signal::Signal<void,int> sig(&multicast_funcs::add);
+		Signal::Signal<void,int> copy(sig);
+
+		multicast_funcs::total = 0;
+		copy.raise(2);
+		AbortIfNot(multicast_funcs::total == 2, false);
+
+		sig.bind(5);
+		copy = sig;
+		copy.raise();
+		AbortIfNot(multicast_funcs::total == 7, false);
+
+		/*
+		 * Handlers that modify an unbound argument each get their own
+		 * copy of it, not one shared by every signal of the same type
+		 */
+		int count = 0;
+		Signal::Signal<void,int&> inc_1([&count](int& n) { count = ++n; });
+		Signal::Signal<void,int&> inc_2([&count](int& n) { count = ++n; });
+
+		inc_1.raise(); inc_1.raise();
+		AbortIfNot(count == 2, false);
+		inc_2.raise();
+		AbortIfNot(count == 1, false);
+
+		Signal::Signal<void,std::string&> app_1(
+			[&last](std::string& str) { last = (str += "a"); });
+		Signal::Signal<void,std::string&> app_2(
+			[&last](std::string& str) { last = (str += "b"); });
+
+		app_1.raise(); app_1.raise();
+		AbortIfNot(last == "aa", false);
+		app_2.raise();
+		AbortIfNot(last == "b", false);
+
+		return true;
+	}
+};
+
+namespace callable_funcs
+{
+	/*
+	 * Records where it was called from, to tell whether a Signal holds
+	 * it inline or on the heap. N pads it out to a given size
+	 */
+	template <std::size_t N>
+	struct located
+	{
+		int operator()(int x)
+		{
+			*where = this;
+			return x + N;
+		}
+
+		const void** where;
+		char pad[N];
+	};
+
+	/*
+	 * A move-only handler
+	 */
+	struct owner
+	{
+		int operator()(int x) const
+		{
+			return *value + x;
+		}
+
+		std::unique_ptr<int> value;
+	};
+
+	/*
+	 * Check whether p lies within obj
+	 */
+	template <class T>
+	bool is_inside(const void* p, const T& obj)
+	{
+		const char* begin = reinterpret_cast<const char*>(&obj);
+		const char* at    = static_cast<const char*>(p);
+
+		return begin <= at && at < begin + sizeof(T);
+	}
+}
+
+class functor_test
+{
+
+public:
+
+	typedef Signal::Signal<int,int> sig_type;
+
+	typedef callable_funcs::located<8>   small;
+	typedef callable_funcs::located<256> large;
+
+	bool run()
+	{
+		/*
+		 * Lambdas with captures, attached and re-attached:
+		 */
+		int calls = 0;
+		sig_type sig([&calls](int x) { calls++; return 2 * x; });
+
+		AbortIfNot(sig.is_connected(), false);
+		AbortIfNot(sig.raise(3) == 6 && calls == 1, false);
+
+		sig.bind(4);
+		AbortIfNot(sig.raise() == 8 && calls == 2, false);
+
+		int offset = 10;
+		AbortIfNot(sig.attach([offset](int x) { return x + offset; }),
+			false);
+		AbortIfNot(sig.raise(1) == 11, false);
+
+		AbortIf(sig.attach(&counter::get), false);
+		AbortIfNot(sig.attach(&priority_funcs::negate), false);
+		AbortIfNot(sig.raise(7) == -7, false);
+
+		/*
+		 * A void Signal discards whatever its handler returns:
+		 */
+		Signal::Signal<void,int> discard([&calls](int x) {
+			calls += x; return calls; });
+		discard.raise(5);
+		AbortIfNot(calls == 7, false);
+
+		/*
+		 * Small callables live inside the Signal, large ones on the
+		 * heap. Either way copies get their own:
+		 */
+		const void* where = nullptr;
+
+		small s; s.where = &where;
+		sig_type inside(s);
+		AbortIfNot(inside.raise(1) == 9, false);
+		AbortIfNot(callable_funcs::is_inside(where, inside), false);
+
+		sig_type inside_copy(inside);
+		inside_copy.raise(1);
+		AbortIfNot(callable_funcs::is_inside(where, inside_copy), false);
+
+		large l; l.where = &where;
+		sig_type outside(l);
+		AbortIfNot(outside.raise(1) == 257, false);
+		AbortIf(callable_funcs::is_inside(where, outside), false);
+
+		const void* first = where;
+		sig_type outside_copy(outside);
+		outside_copy.raise(1);
+		AbortIf(where == first, false);
+
+		sig_type moved(std::move(outside));
+		moved.raise(1);
+		AbortIfNot(where == first, false);
+		AbortIf(outside.is_connected(), false);
+
+		/*
+		 * Move-only callables may be moved but not copied:
+		 */
+		callable_funcs::owner own;
+		own.value.reset(new int(100));
+
+		sig_type unique(std::move(own));
+		AbortIfNot(unique.raise(1) == 101, false);
+
+		std::vector<sig_type> sigs;
+		sigs.push_back(std::move(unique));
+		sigs.resize(10);
+		AbortIfNot(sigs[0].raise(2) == 102, false);
+
+		bool threw = false;
+		try
+		{
+			sig_type copy(sigs[0]);
+		}
+		catch (const std::logic_error&)
+		{
+			threw = true;
+		}
+
+		AbortIfNot(threw, false);
+		AbortIfNot(sigs[0].raise(3) == 103, false);
+
+		/*
+		 * Shared callables:
+		 */
+		sig_type shared([&calls](int x) { calls++; return x; });
+		shared.set_policy(Signal::copy_policy::share);
+
+		sig_type other(shared);
+		other.bind(3);
+		AbortIfNot(shared.raise() == 3, false);
+
+		/*
+		 * Move-only callables can be shared too, whether the policy
+		 * is set before or after the handler is attached:
+		 */
+		own.value.reset(new int(200));
+
+		sig_type shared_owner(std::move(own));
+		shared_owner.set_policy(Signal::copy_policy::share);
+		AbortIfNot(shared_owner.raise(1) == 201, false);
+
+		sig_type owner_copy(shared_owner);
+		AbortIfNot(owner_copy.raise(2) == 202, false);
+
+		own.value.reset(new int(300));
+
+		sig_type late;
+		late.set_policy(Signal::copy_policy::share);
+		AbortIfNot(late.attach(std::move(own)), false);
+		AbortIfNot(late.raise(3) == 303, false);
+
+		sig_type late_copy(late);
+		AbortIfNot(late_copy.raise(4) == 304, false);
+
+		/*
+		 * Going back to deep copies takes the handler back once no
+		 * other Signal shares it, and throws while one still does:
+		 */
+		threw = false;
+		try
+		{
+			owner_copy.set_policy(Signal::copy_policy::deep);
+		}
+		catch (const std::logic_error&)
+		{
+			threw = true;
+		}
+
+		AbortIfNot(threw, false);
+		AbortIfNot(owner_copy.policy() == Signal::copy_policy::share,
+			false);
+		AbortIfNot(owner_copy.raise(5) == 205, false);
+
+		shared_owner.detach();
+		owner_copy.set_policy(Signal::copy_policy::deep);
+		AbortIfNot(owner_copy.raise(6) == 206, false);
+
+		return true;
+	}
+};
+
+#if defined(__linux__)
+namespace reactor_funcs
+{
+	/*
+	 * A pipe that closes itself
+	 */
+	struct pipe_pair
+	{
+		pipe_pair()
+		{
+			fds[0] = fds[1] = -1;
+			AbortIf(::pipe(fds) != 0, );
+		}
+
+		~pipe_pair()
+		{
+			::close(fds[0]); ::close(fds[1]);
+		}
+
+		int read_end()  const { return fds[0]; }
+		int write_end() const { return fds[1]; }
+
+		void send(const char* str)
+		{
+			AbortIf(::write(fds[1], str, std::strlen(str)) < 0, );
+		}
+
+		int fds[2];
+	};
+
+#if defined(SIGNAL_IO_URING)
+	/*
+	 * Cancel the polls of fd pending on any of this process's rings,
+	 * so that they complete with -ECANCELED while fd is still
+	 * registered. Returns false if the kernel cannot do this (it needs
+	 * Linux 6.0 or later)
+	 */
+	bool cancel_polls(int fd)
+	{
+		DIR* dir = ::opendir("/proc/self/fd");
+		if (!dir)
+			return false;
+
+		bool cancelled = false;
+
+		while (const dirent* entry = ::readdir(dir))
+		{
+			const std::string path =
+				std::string("/proc/self/fd/") + entry->d_name;
+
+			char target[64];
+			const ssize_t len =
+				::readlink(path.c_str(), target, sizeof(target) - 1);
+			if (len < 0)
+				continue;
+
+			target[len] = '\0';
+			if (std::strcmp(target, "anon_inode:[io_uring]") != 0)
+				continue;
+
+			io_uring_sync_cancel_reg reg;
+			std::memset(&reg, 0, sizeof(reg));
+
+			reg.fd    = fd;
+			reg.flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+			reg.timeout.tv_sec  = -1;
+			reg.timeout.tv_nsec = -1;
+
+			if (::syscall(__NR_io_uring_register, std::atoi(entry->d_name),
+					IORING_REGISTER_SYNC_CANCEL, &reg, 1) >= 0)
+			{
+				cancelled = true;
+			}
+		}
+
+		::closedir(dir);
+		return cancelled;
+	}
+#endif
+
+	/*
+	 * Reads one byte at a time from each ready pipe, raising a signal
+	 * with what it has read so far
+	 */
+	class reader
+	{
+
+	public:
+
+		reader() : calls(0)
+		{
+		}
+
+		void handle(int fd)
+		{
+			char c;
+			if (::read(fd, &c, 1) == 1)
+				text += c;
+
+			calls++;
+			received.raise(text);
+		}
+
+		int calls;
+
+		Signal::Signal<void,const std::string&> received;
+
+		std::string text;
+	};
+}
+
+class reactor_test
+{
+
+public:
+
+	bool run()
+	{
+		AbortIfNot(run(Signal::reactor_backend::epoll), false);
+		AbortIfNot(run(Signal::reactor_backend::io_uring), false);
+
+		return true;
+	}
+
+	bool run(Signal::reactor_backend backend)
+	{
+		Signal::Reactor reactor(backend, 4);
+		AbortIfNot(reactor.is_open(), false);
+
+		reactor_funcs::pipe_pair a, b;
+		reactor_funcs::reader r;
+
+		std::string last;
+		r.received.attach([&last](const std::string& text) {
+			last = text; });
+
+		AbortIfNot(reactor.add(a.read_end(),
+			Signal::Signal<void,int>(r, &reactor_funcs::reader::handle)),
+			false);
+
+		int b_calls = 0;
+		AbortIfNot(reactor.add(b.read_end(), [&b_calls](int fd) {
+				char buf[16];
+				AbortIf(::read(fd, buf, sizeof(buf)) < 0, );
+				b_calls++;
+			}), false);
+
+		AbortIf(reactor.add(a.read_end(), &multicast_funcs::add), false);
+		AbortIf(reactor.add(-1, &multicast_funcs::add), false);
+		AbortIf(reactor.add(a.write_end(), Signal::Signal<void,int>()),
+			false);
+		AbortIfNot(reactor.size() == 2, false);
+
+		/*
+		 * Nothing is ready yet:
+		 */
+		AbortIfNot(reactor.poll(0) == 0, false);
+
+		/*
+		 * Readiness is level-triggered, so the reader is raised until
+		 * it has read everything:
+		 */
+		a.send("hi");
+		AbortIfNot(reactor.poll(1000) == 1, false);
+		AbortIfNot(reactor.poll(1000) == 1, false);
+		AbortIfNot(reactor.poll(0) == 0, false);
+		AbortIfNot(r.calls == 2 && last == "hi", false);
+
+		/*
+		 * Both are ready at once:
+		 */
+		a.send("!"); b.send("xyz");
+		int raised = 0;
+		for (int i = 0; i < 10 && raised < 2; i++)
+			raised += reactor.poll(1000);
+
+		AbortIfNot(raised == 2, false);
+		AbortIfNot(last == "hi!" && b_calls == 1, false);
+
+#if defined(SIGNAL_IO_URING)
+		/*
+		 * A poll that completes with an error on a file descriptor
+		 * that is still registered is re-armed. poll(0) submits the
+		 * re-arms from the last batch, so there is a poll to cancel:
+		 */
+		AbortIfNot(reactor.poll(0) == 0, false);
+
+		if (reactor.backend() == Signal::reactor_backend::io_uring &&
+			reactor_funcs::cancel_polls(a.read_end()))
+		{
+			AbortIfNot(reactor.poll(1000) == 0, false);
+
+			a.send("?");
+			AbortIfNot(reactor.poll(1000) == 1, false);
+			AbortIfNot(last == "hi!?", false);
+		}
+#endif
+
+		/*
+		 * A handler that removes both itself and another that is ready
+		 * in the same batch:
+		 */
+		AbortIfNot(reactor.remove(a.read_end()), false);
+		AbortIfNot(reactor.remove(b.read_end()), false);
+		AbortIf(reactor.remove(b.read_end()), false);
+		AbortIfNot(reactor.size() == 0, false);
+
+		int removals = 0;
+		auto remover = [&](int) {
+			removals++;
+			reactor.remove(a.read_end());
+			reactor.remove(b.read_end());
+		};
+
+		AbortIfNot(reactor.add(a.read_end(), remover), false);
+		AbortIfNot(reactor.add(b.read_end(), remover), false);
+
+		a.send("a"); b.send("b");
+		for (int i = 0; i < 10 && reactor.size() > 0; i++)
+			reactor.poll(1000);
+
+		AbortIfNot(removals == 1 && reactor.size() == 0, false);
+		AbortIfNot(reactor.poll(0) == 0, false);
+
+		/*
+		 * A handler that replaces itself:
+		 */
+		int replaced = 0;
+		AbortIfNot(reactor.add(a.read_end(), [&](int fd) {
+				reactor.remove(fd);
+				reactor.add(fd, [&replaced](int fd) {
+					char c;
+					AbortIf(::read(fd, &c, 1) < 0, );
+					replaced++;
+				});
+			}), false);
+
+		for (int i = 0; i < 10 && replaced < 1; i++)
+			reactor.poll(1000);
+
+		AbortIfNot(replaced == 1, false);
+
+		/*
+		 * stop() from another thread:
+		 */
+		std::thread stopper([&reactor]() { reactor.stop(); });
+		AbortIfNot(reactor.run(), false);
+		stopper.join();
+
+		return true;
+	}
+};
+#endif
+
+namespace timer_funcs
+{
+	std::vector<int> fired;
+
+	void record(int id)
+	{
+		fired.push_back(id);
+	}
+}
+
+class timer_test
+{
+
+public:
+
+	typedef std::chrono::milliseconds ms;
+
+	bool run()
+	{
+		Signal::TimerWheel wheel(ms(1));
+
+		Signal::Signal<void,int> first(&timer_funcs::record);
+		Signal::Signal<void,int> second(&timer_funcs::record);
+		first.bind(1); second.bind(2);
+
+		/*
+		 * One-shot timers, with delays rounded up to whole ticks:
+		 */
+		const Signal::timer t1 = wheel.schedule(&first, ms(5));
+		wheel.schedule(&second, std::chrono::microseconds(4500));
+		AbortIfNot(wheel.size() == 2 && wheel.is_pending(t1), false);
+
+		AbortIfNot(wheel.tick(4) == 0, false);
+		AbortIfNot(wheel.tick() == 2, false);
+		AbortIfNot(timer_funcs::fired.size() == 2, false);
+		AbortIfNot(timer_funcs::fired[0] == 1 && timer_funcs::fired[1] == 2,
+			false);
+
+		AbortIf(wheel.is_pending(t1) || wheel.cancel(t1), false);
+		AbortIfNot(wheel.size() == 0, false);
+
+		/*
+		 * Cancelling, including through a handle whose timer has been
+		 * replaced:
+		 */
+		timer_funcs::fired.clear();
+
+		const Signal::timer t2 = wheel.schedule(&first, ms(1));
+		AbortIfNot(wheel.cancel(t2), false);
+		AbortIf(wheel.cancel(t2), false);
+
+		const Signal::timer t3 = wheel.schedule(&second, ms(1));
+		AbortIf(t3 == t2 || wheel.cancel(t2), false);
+		AbortIfNot(wheel.tick() == 1, false);
+		AbortIfNot(timer_funcs::fired.size() == 1 &&
+				   timer_funcs::fired[0] == 2, false);
+
+		/*
+		 * Periodic timers:
+		 */
+		timer_funcs::fired.clear();
+
+		const Signal::timer t4 = wheel.schedule(&first, ms(3), ms(3));
+		AbortIfNot(wheel.tick(9) == 3, false);
+		AbortIfNot(wheel.is_pending(t4) && wheel.cancel(t4), false);
+		AbortIfNot(wheel.tick(9) == 0, false);
+
+		/*
+		 * Timers far enough out to start in the upper levels:
+		 */
+		timer_funcs::fired.clear();
+
+		const std::uint64_t start = wheel.now();
+		wheel.schedule(&first,  ms(70000));
+		wheel.schedule(&second, ms(20000000));
+
+		AbortIfNot(wheel.tick(69999) == 0, false);
+		AbortIfNot(wheel.tick() == 1, false);
+		AbortIfNot(wheel.tick(20000000 - 70001) == 0, false);
+		AbortIfNot(wheel.tick() == 1, false);
+		AbortIfNot(wheel.now() - start == 20000000, false);
+		AbortIfNot(timer_funcs::fired.size() == 2 &&
+				   timer_funcs::fired[1] == 2, false);
+
+		/*
+		 * Copies are fired with the arguments bound when they were
+		 * scheduled:
+		 */
+		timer_funcs::fired.clear();
+
+		wheel.schedule(first, ms(2));
+		const Signal::timer owned = wheel.schedule(first, ms(2), ms(1));
+		first.bind(10);
+		wheel.schedule(first, ms(2));
+
+		AbortIfNot(wheel.tick(3) == 4, false);
+		AbortIfNot(timer_funcs::fired.size() == 4, false);
+		AbortIfNot(timer_funcs::fired[0] == 1 && timer_funcs::fired[2] == 10,
+			false);
+		AbortIfNot(wheel.size() == 1, false);
+
+		/*
+		 * A periodic handler that cancels itself and the periodic copy
+		 * (which is due on the same tick, and so fires first), then
+		 * schedules another timer:
+		 */
+		Signal::timer self;
+		int calls = 0;
+
+		Signal::Signal<void> once([&]() {
+			calls++;
+			AbortIfNot(wheel.cancel(self), );
+			AbortIfNot(wheel.cancel(owned), );
+			wheel.schedule(&second, ms(1));
+		});
+
+		self = wheel.schedule(&once, ms(1), ms(1));
+
+		timer_funcs::fired.clear();
+		AbortIfNot(wheel.tick(5) == 3 && calls == 1, false);
+		AbortIfNot(wheel.size() == 0, false);
+		AbortIfNot(timer_funcs::fired.size() == 2, false);
+		AbortIfNot(timer_funcs::fired[0] == 1 && timer_funcs::fired[1] == 2,
+			false);
+
+#if defined(__linux__)
+		/*
+		 * Driving the wheel from its timerfd with a Reactor:
+		 */
+		Signal::Reactor reactor;
+		const int fd = wheel.fd();
+		AbortIf(fd == -1, false);
+
+		AbortIfNot(reactor.add(fd, [&wheel](int) { wheel.on_ready(); }),
+			false);
+
+		timer_funcs::fired.clear();
+		wheel.schedule(&second, ms(2));
+
+		for (int i = 0; i < 100 && wheel.size() > 0; i++)
+			reactor.poll(100);
+
+		AbortIfNot(timer_funcs::fired.size() == 1, false);
+#endif
+
+		return true;
+	}
+};
+
+#if defined(__cpp_impl_coroutine)
+namespace coroutine_funcs
+{
+	/*
+	 * A coroutine that stays suspended at its end, so that the test
+	 * can destroy it (including while it is waiting)
+	 */
+	struct frame
+	{
+		struct promise_type
+		{
+			frame get_return_object()
+			{
+				return frame{
+					std::coroutine_handle<promise_type>::from_promise(*this)};
+			}
+
+			std::suspend_never initial_suspend() noexcept
+			{
+				return std::suspend_never();
+			}
+
+			std::suspend_always final_suspend() noexcept
+			{
+				return std::suspend_always();
+			}
+
+			void return_void()
+			{
+			}
+
+			void unhandled_exception()
+			{
+				std::terminate();
+			}
+		};
+
+		std::coroutine_handle<promise_type> handle;
+	};
+
+	std::vector<std::string> log;
+
+	frame listen(Signal::Awaitable<void,int,std::string>& sig,
+				 std::string name, int times)
+	{
+		for (int i = 0; i < times; i++)
+		{
+			auto [id, text] = co_await sig;
+			log.push_back(name + ":" + std::to_string(id) + text);
+		}
+	}
+
+	Signal::async_handler respond(Signal::Awaitable<int,int>& response,
+								  int request)
+	{
+		auto [status] = co_await response;
+		log.push_back(std::to_string(request) + "->" +
+					  std::to_string(status));
+	}
+
+	/*
+	 * Waits for the last response, then destroys the signal it came on
+	 */
+	Signal::async_handler finish(
+		std::unique_ptr<Signal::Awaitable<int,int>>& response, int request)
+	{
+		auto [status] = co_await *response;
+		log.push_back(std::to_string(request) + "->" +
+					  std::to_string(status));
+
+		response.reset();
+	}
+}
+
+class awaitable_test
+{
+
+public:
+
+	bool run()
+	{
+		using coroutine_funcs::log;
+
+		Signal::Awaitable<void,int,std::string> sig;
+
+		/*
+		 * Waiting coroutines resume in order, and wait for the next
+		 * raise if they wait again:
+		 */
+		coroutine_funcs::frame a = coroutine_funcs::listen(sig, "a", 2);
+		coroutine_funcs::frame b = coroutine_funcs::listen(sig, "b", 1);
+
+		AbortIfNot(sig.waiting() == 2, false);
+
+		sig.raise(1, "x");
+		AbortIfNot(sig.waiting() == 1, false);
+		AbortIfNot(log.size() == 2, false);
+		AbortIfNot(log[0] == "a:1x" && log[1] == "b:1x", false);
+
+		AbortIfNot(b.handle.done(), false);
+		b.handle.destroy();
+
+		/*
+		 * Bound arguments, raised through a generic:
+		 */
+		sig.bind(2, "y");
+
+		Signal::generic* gen = &sig;
+		gen->v_raise();
+
+		AbortIfNot(log.size() == 3 && log[2] == "a:2y", false);
+		AbortIfNot(sig.waiting() == 0 && a.handle.done(), false);
+		a.handle.destroy();
+
+		/*
+		 * A coroutine destroyed while waiting stops waiting:
+		 */
+		coroutine_funcs::frame c = coroutine_funcs::listen(sig, "c", 1);
+		coroutine_funcs::frame d = coroutine_funcs::listen(sig, "d", 1);
+		AbortIfNot(sig.waiting() == 2, false);
+
+		c.handle.destroy();
+		AbortIfNot(sig.waiting() == 1, false);
+
+		log.clear();
+		sig.raise(3, "z");
+		AbortIfNot(log.size() == 1 && log[0] == "d:3z", false);
+		d.handle.destroy();
+
+		/*
+		 * Coroutine handlers, and the handler of an Awaitable running
+		 * after its waiting coroutines:
+		 */
+		Signal::Awaitable<int,int> response([](int status) {
+			log.push_back("handler");
+			return status + 1;
+		});
+
+		Signal::Signal<Signal::async_handler,int> request(
+			[&response](int id) {
+				return coroutine_funcs::respond(response, id); });
+
+		log.clear();
+		request.raise(7);
+		request.raise(8);
+		AbortIfNot(response.waiting() == 2 && log.empty(), false);
+
+		AbortIfNot(response.raise(200) == 201, false);
+		AbortIfNot(log.size() == 3, false);
+		AbortIfNot(log[0] == "7->200" && log[1] == "8->200" &&
+				   log[2] == "handler", false);
+
+		Signal::Awaitable<int,int> unattached;
+		AbortIfNot(unattached.raise(1) == 0, false);
+
+		/*
+		 * Waiting on a timer:
+		 */
+		Signal::TimerWheel wheel;
+		Signal::Awaitable<void> alarm;
+
+		int woken = 0;
+		Signal::Signal<Signal::async_handler> sleeper(
+			[&]() -> Signal::async_handler {
+				co_await alarm;
+				woken++;
+			});
+
+		sleeper.raise();
+		wheel.schedule(&alarm, std::chrono::milliseconds(3));
+
+		AbortIfNot(wheel.tick(2) == 0 && woken == 0, false);
+		AbortIfNot(wheel.tick()  == 1 && woken == 1, false);
+
+		/*
+		 * Copies don't take the waiting coroutines with them:
+		 */
+		sleeper.raise();
+
+		Signal::Awaitable<void> copy(alarm);
+		AbortIfNot(copy.waiting() == 0 && alarm.waiting() == 1, false);
+
+		std::unique_ptr<Signal::generic> clone(alarm.clone());
+		clone->v_raise();
+		AbortIfNot(woken == 1, false);
+
+		alarm.raise();
+		AbortIfNot(woken == 2, false);
+
+		/*
+		 * Moves take the handler but leave the waiting coroutines, and
+		 * work with move-only handlers:
+		 */
+		callable_funcs::owner own;
+		own.value.reset(new int(10));
+
+		Signal::Awaitable<int,int> source(std::move(own));
+		coroutine_funcs::respond(source, 1);
+
+		Signal::Awaitable<int,int> moved(std::move(source));
+		AbortIf(source.is_connected(), false);
+		AbortIfNot(source.waiting() == 1 && moved.waiting() == 0, false);
+
+		log.clear();
+		AbortIfNot(moved.raise(1) == 11 && log.empty(), false);
+
+		source = std::move(moved);
+		AbortIfNot(source.raise(2) == 12, false);
+		AbortIfNot(log.size() == 1 && log[0] == "1->2", false);
+
+		/*
+		 * A coroutine may destroy the signal it was resumed by. Others
+		 * resumed by the same raise still run, but the handler doesn't:
+		 */
+		int handled = 0;
+		std::unique_ptr<Signal::Awaitable<int,int>> last(
+			new Signal::Awaitable<int,int>([&handled](int status) {
+				handled++;
+				return status;
+			}));
+
+		coroutine_funcs::finish(last, 3);
+		coroutine_funcs::respond(*last, 4);
+
+		log.clear();
+		AbortIfNot(last->raise(500) == 0, false);
+		AbortIfNot(!last && handled == 0, false);
+		AbortIfNot(log.size() == 2, false);
+		AbortIfNot(log[0] == "3->500" && log[1] == "4->500", false);
+
+		return true;
+	}
+};
+#endif
+
+namespace net
+{
+	class DataBuffer
+	{
+
+	public:
+
+		DataBuffer() : _buf(nullptr), _size(0)
+		{
+		}
+
+		DataBuffer(char* buf, size_t size)
+			: _buf(buf), _size(size)
+		{
+		}
+
+		~DataBuffer()
+		{
+		}
+
+		size_t size() { return _size; }
+
+	private:
+
+		char* _buf; size_t _size;
+	};
+}
+
+char* raw = new char[1024];
+
+class Test
+{
+
+public:
+
+	void func(net::DataBuffer& buf)
+	{
+		buf = net::DataBuffer(raw, 512);
+	}
+
+	void func2(net::DataBuffer buf)
+	{
+		std::printf("%s: buffer is %zu bytes.\n",
+				__FUNCTION__, buf.size());
+		std::fflush(stdout);
+	}
+};
+
+void func(net::DataBuffer& buf)
+{
+	net::DataBuffer b2(raw, 1024);
+	buf = b2;
+}
+
+bool test_fcn_ptr()
+{
+	Signal::fcn_ptr<void,net::DataBuffer&>
+		sig;
+	AbortIfNot(sig.attach(&func), false);
+
+	net::DataBuffer buf;
+	sig.forward(buf);
+
+	sig.raise();
+
+	std::printf("%s: buffer is %zu bytes.\n",
+				__FUNCTION__, buf.size());
+	std::fflush(stdout);
+
+	return true;
+}
+
+bool test_mem_ptr()
+{
+	Test test;
+	Signal::mem_ptr<void,Test,net::DataBuffer&>
+		sig(test);
+
+	AbortIfNot(sig.attach(&Test::func), false);
+
+	net::DataBuffer buf;
+	sig.forward(buf);
+
+	sig.raise();
+
+	std::printf("%s: buffer is %zu bytes.\n",
+				__FUNCTION__, buf.size());
+	std::fflush(stdout);
+
+	return true;
+}
+
+bool test_sig1()
+{
+	Signal::Signal<void,net::DataBuffer&>
+		sig;
+
+	AbortIfNot(sig.attach(&func), false);
+
+	net::DataBuffer buf;
+	sig.forward(buf);
+
+	sig.raise();
+
+	std::printf("%s: buffer is %zu bytes.\n",
+				__FUNCTION__, buf.size());
+	std::fflush(stdout);
+
+	return true;
+}
+
+bool test_sig2()
+{
+	Test test;
+	Signal::Signal<void,net::DataBuffer&>
+		sig;
+
+	AbortIfNot(sig.attach(test, &Test::func), false);
+
+	net::DataBuffer buf;
+	sig.forward(buf);
+
+	sig.raise();
+
+	std::printf("%s: buffer is %zu bytes.\n",
+				__FUNCTION__, buf.size());
+	std::fflush(stdout);
+
+	return true;
+}
+
+bool test_sig3()
+{
+	Test test;
+	Signal::Signal<void,net::DataBuffer>
+		sig;
+
+	AbortIfNot(sig.attach(test, &Test::func2), false);
+
+	net::DataBuffer buf(nullptr, 10);
+	sig.forward(buf);
+
+	/*
+	 * By-value call using stored pointers:
+	 */
+	sig.raise();
+
+	return true;
+}
+
+int main()
+{
+	mem_ptr_test test1;
+	AbortIfNot(test1.run(), 1);
+
+	std::cout << "\n";
+	
+	fcn_ptr_test test2;
+	AbortIfNot(test2.run(), 1);
+
+	std::cout << "\n";
+
+	signal_test test3;
+	AbortIfNot(test3.run(), 1);
+
+	callable_test test4;
 	AbortIfNot(test4.run(), 1);
 
+	multicast_test test5;
+	AbortIfNot(test5.run(), 1);
+
+	concurrent_multicast_test test6;
+	AbortIfNot(test6.run(), 1);
+
+	queued_test test7;
+	AbortIfNot(test7.run(), 1);
+
+	batch_test test8;
+	AbortIfNot(test8.run(), 1);
+
+	forwarding_test test9;
+	AbortIfNot(test9.run(), 1);
+
+	bind_test test10;
+	AbortIfNot(test10.run(), 1);
+
+	retarget_test test11;
+	AbortIfNot(test11.run(), 1);
+
+	static_test test12;
+	AbortIfNot(test12.run(), 1);
+
+	pool_test test13;
+	AbortIfNot(test13.run(), 1);
+
+	registry_test test14;
+	AbortIfNot(test14.run(), 1);
+
+	command_test test15;
+	AbortIfNot(test15.run(), 1);
+
+	copy_test test16;
+	AbortIfNot(test16.run(), 1);
+
+	delegate_test test17;
+	AbortIfNot(test17.run(), 1);
+
+	priority_test test18;
+	AbortIfNot(test18.run(), 1);
+
+	instrument_test test19;
+	AbortIfNot(test19.run(), 1);
+
+	scoped_test test20;
+	AbortIfNot(test20.run(), 1);
+
+	size_test test21;
+	AbortIfNot(test21.run(), 1);
+
+	functor_test test22;
+	AbortIfNot(test22.run(), 1);
+
+#if defined(__linux__)
+	reactor_test test23;
+	AbortIfNot(test23.run(), 1);
+#endif
+
+	timer_test test24;
+	AbortIfNot(test24.run(), 1);
+
+#if defined(__cpp_impl_coroutine)
+	awaitable_test test25;
+	AbortIfNot(test25.run(), 1);
+#endif
+
 	test_fcn_ptr();
 	test_mem_ptr();
 	test_sig1();